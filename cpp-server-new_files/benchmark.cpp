@@ -0,0 +1,241 @@
+//    SearchServer   .
+//        seed,   .
+//       ,        .
+//     malloc_usable_size,      Linux (make run).
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <malloc.h>
+#include <new>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "document.h"
+#include "paginator.h"
+#include "request_queue.h"
+#include "search_server.h"
+#include "snapshot_index.h"
+#include "stop_word_set.h"
+#include "string_processing.h"
+
+using namespace std;
+
+namespace {
+	atomic<uint64_t> allocation_count = 0;
+	//   ,    operator new
+	atomic<int64_t> heap_bytes = 0;
+
+	void ReleaseMemory(void* memory) {
+		if (memory != nullptr) {
+			heap_bytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(memory)), memory_order_relaxed);
+			free(memory);
+		}
+	}
+}
+
+void* operator new(size_t size) {
+	allocation_count.fetch_add(1, memory_order_relaxed);
+	if (void* memory = malloc(size == 0 ? 1 : size)) {
+		heap_bytes.fetch_add(static_cast<int64_t>(malloc_usable_size(memory)), memory_order_relaxed);
+		return memory;
+	}
+	throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+	ReleaseMemory(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	ReleaseMemory(memory);
+}
+
+namespace {
+	const uint32_t SEED = 20240601;
+	const int DOCUMENT_COUNT = 20000;
+	const int VOCABULARY_SIZE = 5000;
+	const int QUERY_COUNT = 2000;
+
+	vector<string> GenerateVocabulary(mt19937& generator) {
+		uniform_int_distribution<int> length(3, 10);
+		uniform_int_distribution<int> letter('a', 'z');
+		vector<string> words;
+		words.reserve(VOCABULARY_SIZE);
+		for (int i = 0; i < VOCABULARY_SIZE; ++i) {
+			string word(length(generator), ' ');
+			for (char& c : word) {
+				c = static_cast<char>(letter(generator));
+			}
+			words.push_back(word + to_string(i));
+		}
+		return words;
+	}
+
+	//      ,    
+	const string& PickWord(const vector<string>& vocabulary, mt19937& generator) {
+		uniform_real_distribution<double> unit(0.0, 1.0);
+		const double u = unit(generator);
+		return vocabulary[static_cast<size_t>(u * u * u * vocabulary.size())];
+	}
+
+	string GenerateText(const vector<string>& vocabulary, mt19937& generator, int min_words, int max_words,
+		double minus_probability) {
+		uniform_int_distribution<int> word_count(min_words, max_words);
+		uniform_real_distribution<double> unit(0.0, 1.0);
+		string text;
+		for (int n = word_count(generator); n > 0; --n) {
+			if (!text.empty()) {
+				text.push_back(' ');
+			}
+			if (unit(generator) < minus_probability) {
+				text.push_back('-');
+			}
+			text += PickWord(vocabulary, generator);
+		}
+		return text;
+	}
+
+	struct Corpus {
+		vector<string> vocabulary;
+		vector<string> documents;
+		vector<vector<int>> ratings;
+		vector<DocumentStatus> statuses;
+		vector<string> queries;
+	};
+
+	Corpus GenerateCorpus() {
+		mt19937 generator(SEED);
+		Corpus corpus;
+		corpus.vocabulary = GenerateVocabulary(generator);
+		const vector<string>& vocabulary = corpus.vocabulary;
+		uniform_int_distribution<int> rating(-10, 10);
+		uniform_int_distribution<int> status(0, 3);
+		for (int i = 0; i < DOCUMENT_COUNT; ++i) {
+			corpus.documents.push_back(GenerateText(vocabulary, generator, 10, 40, 0.0));
+			corpus.ratings.push_back({ rating(generator), rating(generator), rating(generator) });
+			corpus.statuses.push_back(static_cast<DocumentStatus>(status(generator)));
+		}
+		for (int i = 0; i < QUERY_COUNT; ++i) {
+			corpus.queries.push_back(GenerateText(vocabulary, generator, 2, 6, 0.2));
+		}
+		return corpus;
+	}
+
+	template <typename Operation>
+	void RunBenchmark(string_view name, size_t operation_count, Operation operation) {
+		const uint64_t allocations_before = allocation_count.load();
+		const auto start = chrono::steady_clock::now();
+		for (size_t i = 0; i < operation_count; ++i) {
+			operation(i);
+		}
+		const auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start);
+		const uint64_t allocations = allocation_count.load() - allocations_before;
+		const double ns_per_operation = static_cast<double>(elapsed.count()) / operation_count;
+		cout << left << setw(36) << name << right << fixed << setprecision(1)
+			<< setw(14) << ns_per_operation << " ns/op"
+			<< setw(12) << static_cast<double>(allocations) / operation_count << " allocs/op"
+			<< setw(14) << setprecision(0) << 1e9 / ns_per_operation << " op/s" << endl;
+	}
+
+	void PrintHeapUsage(string_view name, int64_t bytes) {
+		cout << left << setw(36) << name << right << fixed << setprecision(1)
+			<< setw(14) << bytes / (1024.0 * 1024.0) << " MB" << endl;
+	}
+}
+
+int main() {
+	const Corpus corpus = GenerateCorpus();
+	cout << "documents: "s << DOCUMENT_COUNT << ", queries: "s << QUERY_COUNT << ", seed: "s << SEED << endl;
+
+	//   ,      
+	size_t checksum = 0;
+
+	// - -    ,     
+	const set<string, less<>> stop_words(corpus.vocabulary.begin(), corpus.vocabulary.begin() + 200);
+	const StopWordSet stop_word_set(stop_words);
+	vector<string_view> tokens;
+	for (size_t i = 0; i < 1000; ++i) {
+		for (const string_view word : SplitIntoWords(corpus.documents[i])) {
+			tokens.push_back(word);
+		}
+	}
+	RunBenchmark("stop word check: set<string>"sv, tokens.size(), [&](size_t i) {
+		checksum += stop_words.count(tokens[i]);
+	});
+	RunBenchmark("stop word check: StopWordSet"sv, tokens.size(), [&](size_t i) {
+		checksum += stop_word_set.Contains(tokens[i]) ? 1 : 0;
+	});
+
+	SearchServer server("and in on"s);
+	RunBenchmark("AddDocument"sv, corpus.documents.size(), [&](size_t i) {
+		server.AddDocument(static_cast<int>(i), corpus.documents[i], corpus.statuses[i], corpus.ratings[i]);
+	});
+
+	const size_t query_count = corpus.queries.size();
+	RunBenchmark("FindTopDocuments(query)"sv, query_count, [&](size_t i) {
+		checksum += server.FindTopDocuments(corpus.queries[i]).size();
+	});
+	RunBenchmark("FindTopDocuments(query, status)"sv, query_count, [&](size_t i) {
+		checksum += server.FindTopDocuments(corpus.queries[i], DocumentStatus::BANNED).size();
+	});
+	RunBenchmark("FindTopDocuments(query, predicate)"sv, query_count, [&](size_t i) {
+		checksum += server.FindTopDocuments(corpus.queries[i], [](int document_id, DocumentStatus, int rating) {
+			return document_id % 2 == 0 && rating > 0;
+		}).size();
+	});
+	RunBenchmark("MatchDocument"sv, query_count, [&](size_t i) {
+		const auto [words, status] = server.MatchDocument(corpus.queries[i], static_cast<int>(i * 7 % DOCUMENT_COUNT));
+		checksum += words.size();
+	});
+
+	//       ,      ;
+	//        
+	const int64_t heap_before_copy = heap_bytes.load();
+	SearchServer compressed_server(server);
+	PrintHeapUsage("SearchServer heap"sv, heap_bytes.load() - heap_before_copy);
+	compressed_server.CompressPostingLists();
+	PrintHeapUsage("SearchServer heap, compressed"sv, heap_bytes.load() - heap_before_copy);
+	RunBenchmark("FindTopDocuments(query), compressed"sv, query_count, [&](size_t i) {
+		checksum += compressed_server.FindTopDocuments(corpus.queries[i]).size();
+	});
+
+	//    : Load  , SnapshotIndex   
+	stringstream snapshot_output;
+	server.Save(snapshot_output);
+	const string snapshot = snapshot_output.str();
+	RunBenchmark("SearchServer::Load"sv, 1, [&](size_t) {
+		stringstream input(snapshot);
+		checksum += SearchServer::Load(input).GetDocumentCount();
+	});
+	RunBenchmark("SnapshotIndex open"sv, 1, [&](size_t) {
+		checksum += SnapshotIndex(snapshot).GetDocumentCount();
+	});
+	const SnapshotIndex snapshot_index(snapshot);
+	RunBenchmark("FindTopDocuments, SnapshotIndex"sv, query_count, [&](size_t i) {
+		checksum += snapshot_index.FindTopDocuments(corpus.queries[i]).size();
+	});
+
+	vector<Document> documents;
+	for (int i = 0; i < DOCUMENT_COUNT; ++i) {
+		documents.push_back({ i, 0.0, i % 10 });
+	}
+	RunBenchmark("Paginate + iterate (page 10)"sv, 100, [&](size_t) {
+		for (const auto& page : Paginate(documents, 10)) {
+			checksum += page.size();
+		}
+	});
+
+	RequestQueue request_queue(server);
+	RunBenchmark("RequestQueue::AddFindRequest"sv, query_count, [&](size_t i) {
+		checksum += request_queue.AddFindRequest(corpus.queries[i]).size();
+	});
+	cout << "checksum: "s << checksum << endl;
+	return 0;
+}
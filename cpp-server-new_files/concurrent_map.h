@@ -0,0 +1,76 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ,   bucket_count ,    .
+// ,    ,      .
+//    Hash  ,    ,   std::map.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ConcurrentMap {
+public:
+	//    ,  .   Access   ,
+	//           .
+	struct Access {
+		std::lock_guard<std::mutex> guard;
+		Value& ref_to_value;
+	};
+
+	ConcurrentMap()
+		: ConcurrentMap(DefaultBucketCount()) {}
+
+	explicit ConcurrentMap(size_t bucket_count)
+		: buckets_(std::max<size_t>(bucket_count, 1)) {}
+
+	Access operator[](const Key& key) {
+		Bucket& bucket = GetBucket(key);
+		return { std::lock_guard<std::mutex>(bucket.mutex), bucket.map[key] };
+	}
+
+	void Erase(const Key& key) {
+		Bucket& bucket = GetBucket(key);
+		std::lock_guard<std::mutex> guard(bucket.mutex);
+		bucket.map.erase(key);
+	}
+
+	//      std::map. ,     .
+	std::map<Key, Value> BuildOrdinaryMap() {
+		std::map<Key, Value> result;
+		MergeInto(result);
+		return result;
+	}
+
+	//  ,    ,    .
+	template <typename Map>
+	void MergeInto(Map& result) {
+		for (Bucket& bucket : buckets_) {
+			std::lock_guard<std::mutex> guard(bucket.mutex);
+			result.insert(bucket.map.begin(), bucket.map.end());
+		}
+	}
+
+	size_t GetBucketCount() const {
+		return buckets_.size();
+	}
+
+private:
+	struct Bucket {
+		std::mutex mutex;
+		std::map<Key, Value> map;
+	};
+
+	std::vector<Bucket> buckets_;
+	Hash hasher_;
+
+	static size_t DefaultBucketCount() {
+		//  ,       
+		return std::max(1u, std::thread::hardware_concurrency()) * 16;
+	}
+
+	Bucket& GetBucket(const Key& key) {
+		return buckets_[hasher_(key) % buckets_.size()];
+	}
+};
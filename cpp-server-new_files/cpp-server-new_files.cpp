@@ -10,11 +10,33 @@
 #include <optional>
 #include <iterator>
 #include <deque>
+#include <execution>
+#include <sstream>
+#include <functional>
+#include <tuple>
+#include <chrono>
+#include <list>
+#include <memory_resource>
+#include <random>
+#include <filesystem>
+#include <fstream>
 
-using namespace std;
+#include "concurrent_map.h"
+#include "document.h"
+#include "paginator.h"
+#include "process_queries.h"
+#include "query_arena.h"
+#include "query_cache.h"
+#include "read_input_functions.h"
+#include "remove_duplicates.h"
+#include "request_queue.h"
+#include "search_cursor.h"
+#include "search_server.h"
+#include "snapshot_index.h"
+#include "stop_word_set.h"
+#include "string_processing.h"
 
-const int MAX_RESULT_DOCUMENT_COUNT = 5;
-const double EPSILON = 1e-6;
+using namespace std;
 
 
 
@@ -83,129 +105,6 @@ ostream& operator<<(ostream& out, const pair<El1, El2>& container) {
 	return out;
 }
 
-//------------------------sprint 5.1 ----------------------------
-
-
-
-template <typename Iterator>
-class IteratorRange {
-public:
-	IteratorRange(Iterator begin, Iterator end)
-		: begin_(begin), end_(end), size_(distance(begin, end)) {}
-
-	Iterator begin() const {
-		return begin_;
-	}
-
-	Iterator end() const {
-		return end_;
-	}
-
-	size_t size() {
-		return size_;
-	}
-
-private:
-	Iterator begin_;
-	Iterator end_;
-	size_t size_;
-
-};
-
-template <typename Iterator>
-class Paginator {
-public:
-	Paginator(Iterator begin, Iterator end, size_t page_size) {
-		Iterator page_begin = begin;
-		Iterator page_end = begin;
-		int pages_count = ceil(double(distance(begin, end)) / page_size);
-		for (int i = 0; i < pages_count; ++i) {
-			if (i == pages_count - 1) {
-				page_end = end;
-			}
-			else {
-				advance(page_end, page_size);
-			}
-			advance(page_begin, page_size * i);
-			paginator_.push_back(IteratorRange<Iterator>(page_begin, page_end));
-		}
-
-	}
-
-	auto begin() const {
-		return paginator_.begin();
-	}
-
-	auto end() const {
-		return paginator_.end();
-	}
-
-	auto size() {
-		return paginator_.size();
-	}
-
-private:
-	vector<IteratorRange<Iterator>> paginator_;
-};
-
-template <typename Iterator>
-ostream& operator<< (std::ostream& out, const IteratorRange<Iterator>& range) {
-	for (Iterator it = range.begin(); it < range.end(); ++it) {
-		out << *it;
-	}
-	return out;
-}
-
-template <typename Container>
-auto Paginate(const Container& c, size_t page_size) {
-	return Paginator(c.begin(), c.end(), page_size);
-}
-
-ostream& operator<<(ostream& os, const Document& doc) {
-	return os << "{ document_id = "s << doc.id << ", relevance = "s << doc.relevance << ", rating = "s << doc.rating << " }"s;
-}
-
-//------------------------sprint 5.2 ----------------------------
-class RequestQueue {
-public:
-	explicit RequestQueue(const SearchServer& search_server)
-		: search_server_(search_server) {
-
-	}
-	//  ""    ,      
-	template <typename DocumentPredicate>
-	vector<Document> AddFindRequest(const string& raw_query, DocumentPredicate document_predicate) {
-		auto result = search_server_.FindTopDocuments(raw_query, document_predicate);
-		if (requests_.size() >= min_in_day_)
-		{
-			requests_.pop_front();
-			noResult_--;
-		}
-		if (result.empty())
-			noResult_++;
-		requests_.push_front({ static_cast<int>(requests_.size()) });
-		return result;
-	}
-	vector<Document> AddFindRequest(const string& raw_query, DocumentStatus status) {
-		return AddFindRequest(raw_query, [status](int document_id, DocumentStatus status_, int rating) { return status_ == status; });
-	}
-	vector<Document> AddFindRequest(const string& raw_query) {
-		return AddFindRequest(raw_query, DocumentStatus::ACTUAL);
-	}
-	int GetNoResultRequests() const {
-		return noResult_;
-	}
-private:
-	struct QueryResult {
-		int result_ = 0;
-	};
-	const SearchServer& search_server_;
-	deque<QueryResult> requests_;
-	const static int min_in_day_ = 1440;
-	int noResult_ = 0;
-};
-
-/*
 // --------      ----------
 template <typename T, typename U>
 void AssertEqualImpl(const T& t, const U& u, const string& t_str, const string& u_str, const string& file,
@@ -261,10 +160,10 @@ void TestExcludeStopWordsFromAddedDocumentContent() {
 	//  ,   ,     -,
 	//   
 	{
-		SearchServer server("");
+		SearchServer server(""s);
 		server.AddDocument(doc_id, content, DocumentStatus::ACTUAL, ratings);
 		const auto found_docs = server.FindTopDocuments("in"s);
-		ASSERT_EQUAL_HINT(found_docs.size(), 1, "Problems with adding a document"s);
+		ASSERT_EQUAL_HINT(found_docs.size(), 1u, "Problems with adding a document"s);
 		const Document& doc0 = found_docs[0];
 		ASSERT_EQUAL_HINT(doc0.id, doc_id, "Problems with adding a document"s);
 	}
@@ -288,8 +187,8 @@ void TestExcludeMinusWordsFromAddedDocumentContent()
 		server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 5, -12, 2, 1 });
 		const auto found_docs = server.FindTopDocuments("  "s); //    vector<Document>  3
 		const auto found_docs_minus = server.FindTopDocuments("  -"s); //   vector<Document>  2, ..   ,      
-		ASSERT_EQUAL(found_docs.size(), 3);
-		ASSERT_EQUAL(found_docs_minus.size(), 2);
+		ASSERT_EQUAL(found_docs.size(), 3u);
+		ASSERT_EQUAL(found_docs_minus.size(), 2u);
 	}
 }
 
@@ -373,7 +272,7 @@ void TestPredicate()
 		[](int document_id, DocumentStatus status, int rating) {return document_id % 2 == 0; });
 	ASSERT_EQUAL(result[0].id, id3);
 	ASSERT_EQUAL(result[1].id, id2);
-	ASSERT_EQUAL(result.size(), 2);
+	ASSERT_EQUAL(result.size(), 2u);
 }
 
 void TestStatus()
@@ -404,12 +303,12 @@ void TestStatus()
 	auto result2 = server.FindTopDocuments(query1, status2);
 	auto result3 = server.FindTopDocuments(query1, status3);
 	auto result4 = server.FindTopDocuments(query1);
-	ASSERT_EQUAL(result1.size(), 2);
-	ASSERT_EQUAL(result4.size(), 2);
+	ASSERT_EQUAL(result1.size(), 2u);
+	ASSERT_EQUAL(result4.size(), 2u);
 	ASSERT_EQUAL(result1[0].id, id1);
-	ASSERT_EQUAL(result2.size(), 1);
+	ASSERT_EQUAL(result2.size(), 1u);
 	ASSERT_EQUAL(result2[0].id, id2);
-	ASSERT_EQUAL(result3.size(), 1);
+	ASSERT_EQUAL(result3.size(), 1u);
 	ASSERT_EQUAL(result3[0].id, id3);
 }
 
@@ -430,6 +329,1021 @@ void TestRelevance()
 	ASSERT(abs(result[0].relevance - 0.138629) < EPSILON);
 }
 
+void TestParallelFindTopDocuments()
+{
+	SearchServer server("  "s);
+	server.AddDocument(0, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(1, "   "s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 5, -12, 2, 1 });
+	server.AddDocument(3, "  "s, DocumentStatus::BANNED, { 9 });
+	server.AddDocument(4, "    "s, DocumentStatus::ACTUAL, { 1, 2 });
+	const string query = "   -"s;
+	const auto seq_docs = server.FindTopDocuments(query);
+	const auto par_docs = server.FindTopDocuments(execution::par, query);
+	ASSERT_EQUAL(seq_docs.size(), par_docs.size());
+	for (size_t i = 0; i < seq_docs.size(); ++i) {
+		ASSERT_EQUAL(seq_docs[i].id, par_docs[i].id);
+		ASSERT(seq_docs[i].relevance == par_docs[i].relevance);
+		ASSERT_EQUAL(seq_docs[i].rating, par_docs[i].rating);
+	}
+	ASSERT_EQUAL(server.FindTopDocuments(execution::par, query, DocumentStatus::BANNED).size(), 1u);
+	ASSERT_EQUAL(server.FindTopDocuments(execution::seq, query, DocumentStatus::BANNED).size(), 1u);
+}
+
+void TestProcessQueries()
+{
+	SearchServer server("  "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+	server.AddDocument(3, "   "s, DocumentStatus::ACTUAL, { 5, -12, 2, 1 });
+	const vector<string> queries = { ""s, ""s, " -"s, " "s };
+	const auto results = ProcessQueries(server, queries);
+	ASSERT_EQUAL(results.size(), queries.size());
+	vector<Document> expected;
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const auto documents = server.FindTopDocuments(queries[i]);
+		ASSERT_EQUAL(results[i].size(), documents.size());
+		expected.insert(expected.end(), documents.begin(), documents.end());
+	}
+	const auto joined = ProcessQueriesJoined(server, queries);
+	ASSERT_EQUAL(joined.size(), expected.size());
+	for (size_t i = 0; i < joined.size(); ++i) {
+		ASSERT_EQUAL(joined[i].id, expected[i].id);
+	}
+}
+
+void TestUnorderedDocumentIds()
+{
+	SearchServer server(""s);
+	server.AddDocument(10, "  "s, DocumentStatus::ACTUAL, { 1 });
+	server.AddDocument(3, " "s, DocumentStatus::ACTUAL, { 2 });
+	server.AddDocument(7, " "s, DocumentStatus::ACTUAL, { 3 });
+	const auto result = server.FindTopDocuments(""s);
+	ASSERT_EQUAL(result.size(), 2u);
+	ASSERT_EQUAL(result[0].id, 10);
+	ASSERT_EQUAL(result[1].id, 3);
+	const auto [words, status] = server.MatchDocument(" "s, 3);
+	ASSERT_EQUAL(words.size(), 2u);
+	ASSERT(get<0>(server.MatchDocument(" -"s, 7)).empty());
+}
+
+void TestRepeatedQueryWords()
+{
+	SearchServer server(""s);
+	server.AddDocument(1, "         "s, DocumentStatus::ACTUAL, { 1 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 2 });
+	const auto single = server.FindTopDocuments(" "s);
+	const auto repeated = server.FindTopDocuments("     "s);
+	ASSERT_EQUAL(single.size(), repeated.size());
+	ASSERT(single[0].relevance == repeated[0].relevance);
+	const auto [words, status] = server.MatchDocument("   - -"s, 1);
+	const vector<string> expected = { ""s, ""s };
+	ASSERT_EQUAL(words, expected);
+}
+
+void TestRemoveDocument()
+{
+	SearchServer server(""s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 1 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 2 });
+	server.AddDocument(3, "   "s, DocumentStatus::ACTUAL, { 3 });
+	const auto& word_freqs = server.GetWordFrequencies(2);
+	ASSERT_EQUAL(word_freqs.size(), 3u);
+	ASSERT(abs(word_freqs.at(""sv) - 0.5) < EPSILON);
+	ASSERT(server.GetWordFrequencies(100).empty());
+
+	server.RemoveDocument(2);
+	ASSERT_EQUAL(server.GetDocumentCount(), 2);
+	ASSERT(server.GetWordFrequencies(2).empty());
+	ASSERT(server.FindTopDocuments(" "s).empty());
+	ASSERT_EQUAL(server.FindTopDocuments(""s).size(), 1u);
+
+	server.RemoveDocument(execution::par, 1);
+	server.RemoveDocument(execution::par, 100);
+	ASSERT_EQUAL(server.GetDocumentCount(), 1);
+	ASSERT_EQUAL(server.GetDocumentId(0), 3);
+	ASSERT(server.FindTopDocuments(""s).empty());
+	server.AddDocument(1, " "s, DocumentStatus::ACTUAL, { 1 });
+	ASSERT_EQUAL(server.FindTopDocuments(""s).size(), 1u);
+}
+
+void TestRemoveLeavesNoTracesInResults()
+{
+	//   :             
+	const auto text = [](int id) {
+		return " "s + (id % 3 == 0 ? ""s : " "s) + (id % 5 == 0 ? " "s : ""s);
+	};
+	SearchServer server(""s);
+	SearchServer expected_server(""s);
+	vector<int> removed;
+	for (int id = 0; id < 200; ++id) {
+		server.AddDocument(id, text(id), DocumentStatus::ACTUAL, { id % 7 });
+		if (id % 4 == 1) {
+			removed.push_back(id);
+		}
+		else {
+			expected_server.AddDocument(id, text(id), DocumentStatus::ACTUAL, { id % 7 });
+		}
+	}
+	server.CompressPostingLists();
+	for (size_t i = 0; i < removed.size(); ++i) {
+		if (i % 2 == 0) {
+			server.RemoveDocument(removed[i]);
+		}
+		else {
+			server.RemoveDocument(execution::par, removed[i]);
+		}
+	}
+
+	const auto check = [&](const SearchServer& checked) {
+		ASSERT_EQUAL(checked.GetDocumentCount(), expected_server.GetDocumentCount());
+		for (const string& query : { ""s, " "s, " -"s, " -"s }) {
+			const auto expected = expected_server.FindTopDocuments(query, DocumentStatus::ACTUAL, 1000);
+			for (const auto& result : { checked.FindTopDocuments(query, DocumentStatus::ACTUAL, 1000),
+				checked.FindTopDocuments(execution::par, query, [](int, DocumentStatus, int) { return true; }, 1000) }) {
+				ASSERT_EQUAL(result.size(), expected.size());
+				for (size_t i = 0; i < result.size(); ++i) {
+					ASSERT_EQUAL(result[i].id, expected[i].id);
+					ASSERT(result[i].relevance == expected[i].relevance);
+				}
+			}
+		}
+		for (const int id : { 0, 3, 5, 198 }) {
+			ASSERT(checked.GetWordFrequencies(id) == expected_server.GetWordFrequencies(id));
+		}
+		ASSERT(checked.GetWordFrequencies(1).empty());
+	};
+	check(server);
+	check(SearchServer(server));
+	stringstream snapshot;
+	server.Save(snapshot);
+	check(SearchServer::Load(snapshot));
+}
+
+void TestGetDocumentIdAfterRemove()
+{
+	SearchServer server(""s);
+	for (int id = 10; id <= 100; id += 10) {
+		server.AddDocument(id, "  "s + to_string(id), DocumentStatus::ACTUAL, { 1 });
+	}
+	server.RemoveDocument(30);
+	server.RemoveDocument(70);
+	server.RemoveDocument(10);
+	server.AddDocument(5, ""s, DocumentStatus::ACTUAL, { 1 });
+	server.RemoveDocument(100);
+	server.AddDocument(100, ""s, DocumentStatus::ACTUAL, { 1 });
+	const vector<int> expected = { 20, 40, 50, 60, 80, 90, 5, 100 };
+	ASSERT_EQUAL(server.GetDocumentCount(), static_cast<int>(expected.size()));
+	for (size_t i = 0; i < expected.size(); ++i) {
+		ASSERT_EQUAL(server.GetDocumentId(static_cast<int>(i)), expected[i]);
+	}
+	for (const int index : { -1, static_cast<int>(expected.size()) }) {
+		try {
+			server.GetDocumentId(index);
+			ASSERT_HINT(false, "index out of range must throw"s);
+		}
+		catch (const out_of_range&) {
+		}
+	}
+
+	stringstream snapshot;
+	server.Save(snapshot);
+	const SearchServer loaded = SearchServer::Load(snapshot);
+	for (size_t i = 0; i < expected.size(); ++i) {
+		ASSERT_EQUAL(loaded.GetDocumentId(static_cast<int>(i)), expected[i]);
+	}
+
+	SearchServer many(""s);
+	vector<int> kept;
+	for (int id = 0; id < 1000; ++id) {
+		many.AddDocument(id, ""s, DocumentStatus::ACTUAL, { 1 });
+	}
+	for (int id = 0; id < 1000; ++id) {
+		if (id % 3 == 1 || id % 7 == 0) {
+			many.RemoveDocument(id);
+		}
+		else {
+			kept.push_back(id);
+		}
+	}
+	for (size_t i = 0; i < kept.size(); ++i) {
+		ASSERT_EQUAL(many.GetDocumentId(static_cast<int>(i)), kept[i]);
+	}
+}
+
+void TestCompactOrdinals()
+{
+	const auto make_text = [](int id, int round) {
+		return "  "s + to_string(id) + "  "s + to_string(round % 3);
+	};
+	SearchServer churned(""s);
+	for (int round = 0; round < 30; ++round) {
+		for (int id = 0; id < 10; ++id) {
+			churned.AddDocument(id, make_text(id, round), DocumentStatus::ACTUAL, { id, round });
+		}
+		if (round == 10) {
+			churned.CompressPostingLists();
+		}
+		for (int id = 9; id >= 0; --id) {
+			//     ,  ,     
+			if (round + 1 < 30 || id % 3 == 1) {
+				churned.RemoveDocument(id);
+			}
+		}
+	}
+	SearchServer fresh(""s);
+	for (int id = 0; id < 10; ++id) {
+		if (id % 3 != 1) {
+			fresh.AddDocument(id, make_text(id, 29), DocumentStatus::ACTUAL, { id, 29 });
+		}
+	}
+
+	for (const string& query : { ""s, "  2 -7"s, "5"s }) {
+		const auto expected = fresh.FindTopDocuments(query, [](int, DocumentStatus, int) { return true; }, 100);
+		const auto result = churned.FindTopDocuments(query, [](int, DocumentStatus, int) { return true; }, 100);
+		ASSERT_EQUAL(result.size(), expected.size());
+		for (size_t i = 0; i < result.size(); ++i) {
+			ASSERT_EQUAL(result[i].id, expected[i].id);
+			ASSERT(result[i].relevance == expected[i].relevance);
+		}
+	}
+	for (int id = 0; id < 10; ++id) {
+		ASSERT(churned.GetWordFrequencies(id) == fresh.GetWordFrequencies(id));
+	}
+	//       
+	stringstream churned_snapshot;
+	churned.Save(churned_snapshot);
+	stringstream fresh_snapshot;
+	fresh.Save(fresh_snapshot);
+	ASSERT(churned_snapshot.str() == fresh_snapshot.str());
+}
+
+void TestCopySearchServer()
+{
+	optional<SearchServer> source(in_place, ""s);
+	source->AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 1 });
+	source->AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 2 });
+	SearchServer copy(*source);
+	SearchServer assigned(""s);
+	assigned = *source;
+	ASSERT(copy.GetGeneration() != source->GetGeneration());
+	ASSERT(assigned.GetGeneration() != copy.GetGeneration());
+	//         
+	source.reset();
+
+	for (SearchServer* server : { &copy, &assigned }) {
+		const auto [words, status] = server->MatchDocument(" "s, 2);
+		ASSERT_EQUAL(words, vector<string>({ ""s, ""s }));
+		ASSERT_EQUAL(server->GetWordFrequencies(1).begin()->first, ""sv);
+		server->RemoveDocument(1);
+		ASSERT_EQUAL(server->GetDocumentCount(), 1);
+		ASSERT_EQUAL(server->FindTopDocuments(""s).size(), 1u);
+		ASSERT(server->FindTopDocuments(""s).empty());
+	}
+}
+
+void TestConcurrentMap()
+{
+	ConcurrentMap<string, int> word_counts(7);
+	const vector<string> words = { ""s, ""s, ""s, ""s, ""s, ""s };
+	for_each(execution::par, words.begin(), words.end(), [&word_counts](const string& word) {
+		++word_counts[word].ref_to_value;
+	});
+	word_counts.Erase(""s);
+	const map<string, int> expected = { { ""s, 3 }, { ""s, 2 } };
+	ASSERT_EQUAL(word_counts.BuildOrdinaryMap(), expected);
+
+	ConcurrentMap<int, double> relevance;
+	ASSERT(relevance.GetBucketCount() > 0);
+	relevance[-5].ref_to_value += 0.5;
+	ASSERT_EQUAL(relevance.BuildOrdinaryMap().at(-5), 0.5);
+}
+
+void TestTopDocumentsCount()
+{
+	SearchServer server(""s);
+	for (int id = 0; id < 20; ++id) {
+		server.AddDocument(id, ""s + string(id % 7, '') + "  "s, DocumentStatus::ACTUAL, { id % 5 });
+	}
+	const auto top_default = server.FindTopDocuments(" "s);
+	ASSERT_EQUAL(top_default.size(), static_cast<size_t>(MAX_RESULT_DOCUMENT_COUNT));
+	const auto top_all = server.FindTopDocuments(" "s, DocumentStatus::ACTUAL, 100);
+	ASSERT_EQUAL(top_all.size(), 20u);
+	const auto top_three = server.FindTopDocuments(execution::par, " "s, DocumentStatus::ACTUAL, 3);
+	ASSERT_EQUAL(top_three.size(), 3u);
+	for (size_t i = 0; i < top_three.size(); ++i) {
+		ASSERT_EQUAL(top_three[i].id, top_all[i].id);
+	}
+	const auto top_even = server.FindTopDocuments(" "s,
+		[](int document_id, DocumentStatus status, int rating) { return document_id % 2 == 0; }, 7);
+	ASSERT_EQUAL(top_even.size(), 7u);
+}
+
+void TestInverseDocumentFreqAfterRemove()
+{
+	SearchServer server(""s);
+	server.AddDocument(1, " "s, DocumentStatus::ACTUAL, { 1 });
+	server.AddDocument(2, " "s, DocumentStatus::ACTUAL, { 2 });
+	server.AddDocument(3, " "s, DocumentStatus::ACTUAL, { 3 });
+	server.RemoveDocument(1);
+	server.AddDocument(4, " "s, DocumentStatus::ACTUAL, { 4 });
+	// 3 , ""    
+	const auto result = server.FindTopDocuments(""s);
+	ASSERT_EQUAL(result.size(), 1u);
+	ASSERT(abs(result[0].relevance - log(3.0) / 2) < EPSILON);
+}
+
+void TestAddDocuments()
+{
+	const vector<string> texts = { "    "s, "   "s,
+		"   "s, " "s };
+	SearchServer single(""s);
+	SearchServer batch(""s);
+	single.AddDocument(5, ""s, DocumentStatus::ACTUAL, { 1 });
+	batch.AddDocument(5, ""s, DocumentStatus::ACTUAL, { 1 });
+	vector<DocumentInput> documents;
+	for (int i = 0; i < static_cast<int>(texts.size()); ++i) {
+		single.AddDocument(10 - i, texts[i], DocumentStatus::ACTUAL, { i, 2 * i });
+		documents.push_back({ 10 - i, texts[i], DocumentStatus::ACTUAL, { i, 2 * i } });
+	}
+	batch.AddDocuments(documents);
+	ASSERT_EQUAL(batch.GetDocumentCount(), single.GetDocumentCount());
+	for (const string& query : { ""s, "  -"s, " "s }) {
+		const auto expected = single.FindTopDocuments(query);
+		const auto result = batch.FindTopDocuments(query);
+		ASSERT_EQUAL(result.size(), expected.size());
+		for (size_t i = 0; i < result.size(); ++i) {
+			ASSERT_EQUAL(result[i].id, expected[i].id);
+			ASSERT(result[i].relevance == expected[i].relevance);
+		}
+	}
+	ASSERT_EQUAL(batch.GetWordFrequencies(9).size(), 3u);
+
+	const vector<DocumentInput> duplicate = { { 20, ""sv }, { 20, ""sv } };
+	const vector<DocumentInput> invalid = { { 21, ""sv }, { 22, "\x12"sv } };
+	for (const auto& bad_batch : { duplicate, invalid }) {
+		try {
+			batch.AddDocuments(bad_batch);
+			ASSERT_HINT(false, "invalid batch was accepted"s);
+		}
+		catch (const invalid_argument&) {
+		}
+	}
+	ASSERT_EQUAL(batch.GetDocumentCount(), single.GetDocumentCount());
+
+	const uint64_t generation = batch.GetGeneration();
+	batch.AddDocuments({});
+	ASSERT_EQUAL(batch.GetGeneration(), generation);
+}
+
+void TestSaveLoad()
+{
+	SearchServer server(" "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::BANNED, { 7, 2, 7 });
+	server.AddDocument(3, "   "s, DocumentStatus::ACTUAL, { 5, -12, 2, 1 });
+	server.RemoveDocument(1);
+	server.AddDocument(1, "   "s, DocumentStatus::ACTUAL, { 4 });
+
+	stringstream snapshot;
+	server.Save(snapshot);
+	const SearchServer loaded = SearchServer::Load(snapshot);
+	ASSERT_EQUAL(loaded.GetDocumentCount(), server.GetDocumentCount());
+	for (int i = 0; i < server.GetDocumentCount(); ++i) {
+		ASSERT_EQUAL(loaded.GetDocumentId(i), server.GetDocumentId(i));
+		const int id = server.GetDocumentId(i);
+		ASSERT_EQUAL(loaded.GetWordFrequencies(id).size(), server.GetWordFrequencies(id).size());
+	}
+	for (const DocumentStatus status : { DocumentStatus::ACTUAL, DocumentStatus::BANNED }) {
+		const auto expected = server.FindTopDocuments("    - "s, status);
+		const auto result = loaded.FindTopDocuments("    - "s, status);
+		ASSERT_EQUAL(result.size(), expected.size());
+		for (size_t i = 0; i < result.size(); ++i) {
+			ASSERT_EQUAL(result[i].id, expected[i].id);
+			ASSERT(result[i].relevance == expected[i].relevance);
+			ASSERT_EQUAL(result[i].rating, expected[i].rating);
+		}
+	}
+
+	stringstream broken(snapshot.str().substr(0, 40));
+	try {
+		SearchServer::Load(broken);
+		ASSERT_HINT(false, "broken snapshot was loaded"s);
+	}
+	catch (const invalid_argument&) {
+	}
+}
+
+void TestSnapshotIndex()
+{
+	SearchServer server(" "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::BANNED, { 7, 2, 7 });
+	server.AddDocument(3, "   "s, DocumentStatus::ACTUAL, { 5, -12, 2, 1 });
+	server.AddDocument(4, "  "s, DocumentStatus::ACTUAL, { 1 });
+	server.RemoveDocument(1);
+	server.AddDocument(1, "   "s, DocumentStatus::ACTUAL, { 4 });
+
+	const string path = (filesystem::temp_directory_path() / "search_server_snapshot_test.bin"s).string();
+	{
+		ofstream output(path, ios::binary);
+		server.Save(output);
+	}
+	{
+		const MappedFile file(path);
+		const SnapshotIndex index(file.GetData());
+		ASSERT_EQUAL(index.GetDocumentCount(), server.GetDocumentCount());
+		const auto check = [](const vector<Document>& result, const vector<Document>& expected) {
+			ASSERT_EQUAL(result.size(), expected.size());
+			for (size_t i = 0; i < result.size(); ++i) {
+				ASSERT_EQUAL(result[i].id, expected[i].id);
+				ASSERT(result[i].relevance == expected[i].relevance);
+				ASSERT_EQUAL(result[i].rating, expected[i].rating);
+			}
+		};
+		for (const string& query : { "    - "s, " -"s, ""s, ""s }) {
+			check(index.FindTopDocuments(query), server.FindTopDocuments(query));
+			check(index.FindTopDocuments(query, DocumentStatus::BANNED), server.FindTopDocuments(query, DocumentStatus::BANNED));
+			const auto odd_id = [](int document_id, DocumentStatus, int) { return document_id % 2 == 1; };
+			check(index.FindTopDocuments(query, odd_id, 2), server.FindTopDocuments(query, odd_id, 2));
+		}
+		try {
+			index.FindTopDocuments(" --"s);
+			ASSERT_HINT(false, "invalid query was accepted"s);
+		}
+		catch (const invalid_argument&) {
+		}
+	}
+	filesystem::remove(path);
+
+	try {
+		MappedFile missing(path);
+		ASSERT_HINT(false, "missing file was mapped"s);
+	}
+	catch (const runtime_error&) {
+	}
+	stringstream snapshot;
+	server.Save(snapshot);
+	const string data = snapshot.str();
+	for (const size_t size : { size_t{ 0 }, size_t{ 40 }, data.size() - 8 }) {
+		try {
+			SnapshotIndex broken(string_view(data).substr(0, size));
+			ASSERT_HINT(false, "broken snapshot was opened"s);
+		}
+		catch (const invalid_argument&) {
+		}
+	}
+}
+
+//      from  to
+string PatchSnapshot(const string& snapshot, const string& from, const string& to)
+{
+	const size_t position = snapshot.find(from);
+	ASSERT_HINT(position != string::npos && snapshot.find(from, position + 1) == string::npos,
+		"pattern must occur in the snapshot exactly once"s);
+	string result = snapshot;
+	result.replace(position, from.size(), to);
+	return result;
+}
+
+void TestLoadRejectsBrokenSnapshots()
+{
+	//   0..7: "xq"  {5, 7}, "xr"  {5, 6},  5  6 - BANNED  IRRELEVANT
+	SearchServer server(""s);
+	for (int ordinal = 0; ordinal < 8; ++ordinal) {
+		const string text = ordinal == 5 ? "xq xr"s : ordinal == 6 ? "xr"s : ordinal == 7 ? "xq"s : "yy"s;
+		const DocumentStatus status = ordinal == 5 ? DocumentStatus::BANNED
+			: ordinal == 6 ? DocumentStatus::IRRELEVANT : DocumentStatus::ACTUAL;
+		server.AddDocument(100 + ordinal, text, status, { 1000 + ordinal });
+	}
+	stringstream output;
+	server.Save(output);
+	const string snapshot = output.str();
+	{
+		stringstream input(snapshot);
+		ASSERT_EQUAL(SearchServer::Load(input).FindTopDocuments("xq"s).size(), 1u);
+	}
+
+	const auto int32 = [](int value) {
+		string bytes(4, '\0');
+		for (int i = 0; i < 4; ++i) {
+			bytes[i] = static_cast<char>(value >> (8 * i) & 0xFF);
+		}
+		return bytes;
+	};
+	const string xq_postings = int32(5) + int32(7);
+	const string statuses = int32(2) + int32(1);
+	const vector<pair<string, string>> broken_snapshots = {
+		{ "unsorted postings"s, PatchSnapshot(snapshot, xq_postings, int32(7) + int32(5)) },
+		{ "duplicate postings"s, PatchSnapshot(snapshot, xq_postings, int32(7) + int32(7)) },
+		{ "posting out of range"s, PatchSnapshot(snapshot, xq_postings, int32(5) + int32(8)) },
+		{ "negative posting"s, PatchSnapshot(snapshot, xq_postings, int32(-1) + int32(7)) },
+		{ "unknown status"s, PatchSnapshot(snapshot, statuses, int32(77) + int32(1)) },
+		{ "repeated word"s, PatchSnapshot(snapshot, "xr"s, "xq"s) },
+		{ "unsorted words"s, PatchSnapshot(snapshot, "xq"s, "xs"s) },
+		{ "truncated"s, snapshot.substr(0, snapshot.size() - 8) },
+	};
+	for (const auto& [name, broken] : broken_snapshots) {
+		stringstream input(broken);
+		try {
+			SearchServer::Load(input);
+			ASSERT_HINT(false, name + " snapshot was loaded"s);
+		}
+		catch (const invalid_argument&) {
+		}
+	}
+}
+
+void TestCompressPostingLists()
+{
+	SearchServer server(" "s);
+	//      "",    
+	for (int id = 0; id < 300; ++id) {
+		const string text = (id % 3 == 0) ? "  "s : (id % 3 == 1) ? "    "s : " "s;
+		server.AddDocument(id * 7, text, DocumentStatus::ACTUAL, { id % 10 });
+	}
+	const string query = "   -"s;
+	const auto expected = server.FindTopDocuments(query, [](int, DocumentStatus, int) { return true; }, 1000);
+
+	server.CompressPostingLists();
+	const auto check = [&](const vector<Document>& result) {
+		ASSERT_EQUAL(result.size(), expected.size());
+		for (size_t i = 0; i < result.size(); ++i) {
+			ASSERT_EQUAL(result[i].id, expected[i].id);
+			ASSERT(result[i].relevance == expected[i].relevance);
+		}
+	};
+	check(server.FindTopDocuments(query, [](int, DocumentStatus, int) { return true; }, 1000));
+	check(server.FindTopDocuments(execution::par, query, [](int, DocumentStatus, int) { return true; }, 1000));
+
+	const auto [words, status] = server.MatchDocument(" "s, 7);
+	ASSERT_EQUAL(words.size(), 2u);
+
+	//     
+	server.RemoveDocument(0);
+	server.AddDocument(5000, ""s, DocumentStatus::ACTUAL, { 1 });
+	const auto result = server.FindTopDocuments(""s, [](int, DocumentStatus, int) { return true; }, 1000);
+	ASSERT_EQUAL(result.size(), 200u);
+	ASSERT_EQUAL(result[0].id, 5000);
+}
+
+void TestMinusWordsOnLongPostingLists()
+{
+	SearchServer server(""s);
+	for (int id = 0; id < 2000; ++id) {
+		string text = ""s;
+		if (id % 2 == 0) {
+			text += " "s;
+		}
+		if (id % 3 == 0) {
+			text += " "s;
+		}
+		if (id % 97 == 0) {
+			text += " "s;
+		}
+		server.AddDocument(id, text, DocumentStatus::ACTUAL, { 1 });
+	}
+	//  -,         
+	const vector<tuple<string, function<bool(int)>>> cases = {
+		{ " -"s, [](int id) { return id % 2 == 0 && id % 97 != 0; } },
+		{ " -"s, [](int id) { return id % 97 == 0 && id % 2 != 0; } },
+		{ " -"s, [](int id) { return id % 2 == 0 && id % 3 != 0; } },
+		{ " - - -"s, [](int id) { return id % 2 != 0 && id % 3 != 0 && id % 97 != 0; } },
+	};
+	const auto check = [&]() {
+		for (const auto& [query, expected] : cases) {
+			for (const bool parallel : { false, true }) {
+				const auto any = [](int, DocumentStatus, int) { return true; };
+				const auto result = parallel
+					? server.FindTopDocuments(execution::par, query, any, 2000)
+					: server.FindTopDocuments(query, any, 2000);
+				int expected_count = 0;
+				for (int id = 0; id < server.GetDocumentCount(); ++id) {
+					expected_count += expected(id) ? 1 : 0;
+				}
+				ASSERT_EQUAL(static_cast<int>(result.size()), expected_count);
+				for (const Document& document : result) {
+					ASSERT_HINT(expected(document.id), query);
+				}
+			}
+		}
+	};
+	check();
+	server.CompressPostingLists();
+	check();
+	const auto [words, status] = server.MatchDocument(" "s, 97 * 6);
+	ASSERT_EQUAL(words.size(), 2u);
+}
+
+void TestParallelMatchDocument()
+{
+	SearchServer server(" "s);
+	server.AddDocument(1, "     "s, DocumentStatus::BANNED, { 7, 2, 7 });
+	server.AddDocument(2, " "s, DocumentStatus::ACTUAL, { 5 });
+
+	for (const bool parallel : { false, true }) {
+		const auto [words, status] = parallel
+			? server.MatchDocument(execution::par, "     "s, 1)
+			: server.MatchDocument(execution::seq, "     "s, 1);
+		const vector<string_view> expected = { ""sv, ""sv, ""sv };
+		ASSERT(words == expected);
+		ASSERT(status == DocumentStatus::BANNED);
+		//    ,     
+		ASSERT(words[0].data() == server.GetWordFrequencies(1).begin()->first.data());
+	}
+	ASSERT(get<0>(server.MatchDocument(execution::par, " -"s, 1)).empty());
+	ASSERT(get<0>(server.MatchDocument(execution::par, "- "s, 2)).size() == 1);
+	try {
+		server.MatchDocument(execution::par, ""s, 3);
+		ASSERT_HINT(false, "unknown id was matched"s);
+	}
+	catch (const out_of_range&) {
+	}
+}
+
+void TestQueryCache()
+{
+	SearchServer server(" "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+	QueryCache cache(server, 2);
+
+	ASSERT_EQUAL(server.GetNormalizedQuery("  -  "s), "  -"s);
+	const auto first = cache.FindTopDocuments(" -"s);
+	//         
+	const auto second = cache.FindTopDocuments("-   "s);
+	ASSERT_EQUAL(cache.GetMissCount(), 1);
+	ASSERT_EQUAL(cache.GetHitCount(), 1);
+	ASSERT_EQUAL(second.size(), first.size());
+	ASSERT_EQUAL(second[0].id, 1);
+
+	//   -  
+	cache.FindTopDocuments(" -"s, DocumentStatus::BANNED);
+	cache.FindTopDocuments(""s, "rating>7"sv, [](int, DocumentStatus, int rating) { return rating > 7; });
+	ASSERT_EQUAL(cache.GetMissCount(), 3);
+	ASSERT_EQUAL(cache.GetSize(), 2u);
+	cache.FindTopDocuments(" -"s);
+	ASSERT_EQUAL(cache.GetMissCount(), 4);
+
+	//       
+	server.AddDocument(3, ""s, DocumentStatus::ACTUAL, { 1 });
+	ASSERT_EQUAL(cache.FindTopDocuments(" -"s).size(), 2u);
+	ASSERT_EQUAL(cache.GetMissCount(), 5);
+	server.RemoveDocument(3);
+	ASSERT_EQUAL(cache.FindTopDocuments(" -"s).size(), 1u);
+	ASSERT_EQUAL(cache.GetMissCount(), 6);
+}
+
+void TestRequestQueueWindow()
+{
+	SearchServer server(" "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+
+	chrono::steady_clock::time_point now;
+	RequestQueue queue(server, [&now]() { return now; });
+	queue.AddFindRequest(""s);
+	queue.AddFindRequest(""s);
+	now += chrono::hours(12);
+	queue.AddFindRequest(""s);
+	RequestStats stats = queue.GetStats();
+	ASSERT_EQUAL(stats.requests, 3);
+	ASSERT_EQUAL(stats.no_result, 1);
+	ASSERT_EQUAL(stats.result_sizes[0], 1);
+	ASSERT_EQUAL(stats.result_sizes[1], 1);
+	ASSERT_EQUAL(stats.result_sizes[2], 1);
+	ASSERT(queue.GetLatencyPercentile(0.5) <= queue.GetLatencyPercentile(0.99));
+	ASSERT(queue.GetLatencyPercentile(1.0) > chrono::microseconds(0));
+
+	//         
+	now += chrono::hours(12);
+	ASSERT_EQUAL(queue.GetRequestCount(), 1);
+	ASSERT_EQUAL(queue.GetNoResultRequests(), 0);
+	now += chrono::hours(24 * 3);
+	ASSERT_EQUAL(queue.GetRequestCount(), 0);
+
+	//    -  1440 
+	RequestQueue counted(server);
+	for (int i = 0; i < RequestWindow::MINUTES_IN_DAY + 10; ++i) {
+		counted.AddFindRequest(i < 20 ? ""s : ""s);
+	}
+	ASSERT_EQUAL(counted.GetRequestCount(), RequestWindow::MINUTES_IN_DAY);
+	ASSERT_EQUAL(counted.GetNoResultRequests(), 10);
+}
+
+void TestConcurrentRequestQueue()
+{
+	SearchServer server(" "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+
+	ConcurrentRequestQueue queue(server);
+	vector<int> requests(2000);
+	iota(requests.begin(), requests.end(), 0);
+	for_each(execution::par, requests.begin(), requests.end(), [&queue](int i) {
+		queue.AddFindRequest(i % 4 == 0 ? ""s : ""s);
+	});
+	//    1440 ,     -    
+	const RequestStats stats = queue.GetStats();
+	ASSERT_EQUAL(stats.requests, RequestWindow::MINUTES_IN_DAY);
+	ASSERT_EQUAL(stats.result_sizes[0], stats.no_result);
+	ASSERT_EQUAL(stats.result_sizes[0] + stats.result_sizes[2], stats.requests);
+	ASSERT(stats.no_result > 0 && stats.no_result < RequestWindow::MINUTES_IN_DAY);
+
+	for (int i = 0; i < RequestWindow::MINUTES_IN_DAY; ++i) {
+		queue.AddFindRequest(""s);
+	}
+	ASSERT_EQUAL(queue.GetNoResultRequests(), RequestWindow::MINUTES_IN_DAY);
+}
+
+void TestPaginator()
+{
+	const vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7 };
+	const auto pages = Paginate(numbers, 3);
+	ASSERT_EQUAL(pages.size(), 3u);
+	vector<vector<int>> contents;
+	for (const auto& page : pages) {
+		contents.emplace_back(page.begin(), page.end());
+	}
+	const vector<vector<int>> expected = { { 1, 2, 3 }, { 4, 5, 6 }, { 7 } };
+	ASSERT(contents == expected);
+	ASSERT_EQUAL(*pages[1].begin(), 4);
+	ASSERT_EQUAL(pages[2].size(), 1u);
+
+	//     
+	const list<int> numbers_list(numbers.begin(), numbers.end());
+	contents.clear();
+	for (const auto& page : Paginate(numbers_list, 3)) {
+		contents.emplace_back(page.begin(), page.end());
+	}
+	ASSERT(contents == expected);
+
+	ASSERT_EQUAL(Paginate(vector<int>{}, 2).size(), 0u);
+	try {
+		Paginate(numbers, 0);
+		ASSERT_HINT(false, "zero page size was accepted"s);
+	}
+	catch (const invalid_argument&) {
+	}
+}
+
+void TestSearchCursor()
+{
+	SearchServer server(""s);
+	for (int id = 0; id < 23; ++id) {
+		server.AddDocument(id, (id % 2 == 0) ? "  "s : "  "s, DocumentStatus::ACTUAL, { id % 5 });
+	}
+	server.AddDocument(50, ""s, DocumentStatus::ACTUAL, { 1 });
+	SearchCursor cursor(server, ""s);
+	vector<Document> all;
+	while (cursor.HasMore()) {
+		const vector<Document> page = cursor.NextPage(5);
+		ASSERT(!page.empty() && page.size() <= 5);
+		all.insert(all.end(), page.begin(), page.end());
+	}
+	ASSERT_EQUAL(all.size(), 23u);
+	ASSERT(cursor.NextPage(5).empty());
+	//     FindTopDocuments      
+	const auto top = server.FindTopDocuments(""s);
+	for (size_t i = 0; i < top.size(); ++i) {
+		ASSERT(all[i].relevance == top[i].relevance);
+		ASSERT_EQUAL(all[i].rating, top[i].rating);
+	}
+	set<int> ids;
+	for (const Document& document : all) {
+		ids.insert(document.id);
+	}
+	ASSERT_EQUAL(ids.size(), 23u);
+
+	//        -    
+	SearchCursor first(server, ""s);
+	const vector<Document> first_page = first.NextPage(7);
+	server.AddDocument(100, ""s, DocumentStatus::ACTUAL, { 1 });
+	SearchCursor resumed(server, ""s, [](int, DocumentStatus status, int) { return status == DocumentStatus::ACTUAL; },
+		*first.GetToken());
+	const vector<Document> rest = resumed.NextPage(100);
+	ASSERT_EQUAL(first_page.size() + rest.size(), 23u);
+	ASSERT_EQUAL(rest[0].id, all[7].id);
+	ASSERT_EQUAL(first.NextPage(100).size(), rest.size());
+}
+
+void TestSearchCursorNearlyEqualRelevance()
+{
+	//      ,    
+	//    EPSILON.     ,    
+	//  EPSILON     .
+	SearchServer server(""s);
+	vector<int> expected;
+	for (int id = 1; id <= 8; ++id) {
+		string text = ""s;
+		for (int i = 0; i < 998 + id; ++i) {
+			text += " "s;
+		}
+		server.AddDocument(id, text, DocumentStatus::ACTUAL, { id });
+		expected.push_back(id);
+	}
+	// IDF = log(13 / 8):    EPSILON,  - 
+	for (int id = 100; id < 105; ++id) {
+		server.AddDocument(id, ""s, DocumentStatus::ACTUAL, { 1 });
+	}
+	const auto all = server.FindMatchingDocuments(""s, [](int, DocumentStatus, int) { return true; });
+	const auto [least, most] = minmax_element(all.begin(), all.end(), [](const Document& lhs, const Document& rhs) {
+		return lhs.relevance < rhs.relevance;
+	});
+	ASSERT(most->relevance - least->relevance > EPSILON);
+	ASSERT(most->relevance - least->relevance < EPSILON * (all.size() - 1));
+
+	SearchCursor cursor(server, ""s);
+	vector<int> ids;
+	vector<SearchCursor::ContinuationToken> tokens;
+	for (vector<Document> page = cursor.NextPage(1); !page.empty(); page = cursor.NextPage(1)) {
+		ids.push_back(page[0].id);
+		tokens.push_back(*cursor.GetToken());
+	}
+	ASSERT_EQUAL(ids, expected);
+	for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+		SearchCursor resumed(server, ""s, [](int, DocumentStatus, int) { return true; }, tokens[i]);
+		vector<int> rest;
+		for (const Document& document : resumed.NextPage(100)) {
+			rest.push_back(document.id);
+		}
+		ASSERT_EQUAL(rest, vector<int>(expected.begin() + i + 1, expected.end()));
+	}
+}
+
+void TestRemoveDuplicates()
+{
+	SearchServer server("and with"s);
+	server.AddDocument(1, "funny pet and nasty rat"s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+	server.AddDocument(2, "funny pet with curly hair"s, DocumentStatus::ACTUAL, { 1, 2 });
+	//   -  
+	server.AddDocument(3, "funny pet with curly hair and hair hair"s, DocumentStatus::ACTUAL, { 1, 2 });
+	server.AddDocument(4, "curly hair funny pet"s, DocumentStatus::ACTUAL, { 1, 2 });
+	server.AddDocument(6, "nasty rat funny pet"s, DocumentStatus::ACTUAL, { 1, 2 });
+	//   -  
+	server.AddDocument(5, "funny pet"s, DocumentStatus::ACTUAL, { 1, 2 });
+	ASSERT_EQUAL(RemoveDuplicates(server), vector<int>({ 3, 4, 6 }));
+	ASSERT_EQUAL(server.GetDocumentCount(), 3);
+	ASSERT(!server.GetWordFrequencies(1).empty());
+	ASSERT(!server.GetWordFrequencies(2).empty());
+	ASSERT(!server.GetWordFrequencies(5).empty());
+	ASSERT(server.GetWordFrequencies(6).empty());
+	ASSERT_EQUAL(server.FindTopDocuments("curly"s).size(), 1u);
+	ASSERT_EQUAL(server.FindTopDocuments("rat"s).size(), 1u);
+	ASSERT(RemoveDuplicates(server).empty());
+}
+
+void TestRemoveDocuments()
+{
+	SearchServer server(""s);
+	for (int id = 0; id < 300; ++id) {
+		server.AddDocument(id, "  "s + to_string(id) + (id % 2 == 0 ? " "s : " "s),
+			DocumentStatus::ACTUAL, { id });
+	}
+	server.CompressPostingLists();
+	vector<int> removed;
+	for (int id = 0; id < 300; id += 2) {
+		removed.push_back(id);
+	}
+	//  id   
+	removed.push_back(1000);
+	removed.push_back(4);
+	server.RemoveDocuments(removed);
+	ASSERT_EQUAL(server.GetDocumentCount(), 150);
+	ASSERT(server.FindTopDocuments(""s).empty());
+	ASSERT(server.FindTopDocuments("4"s).empty());
+	ASSERT_EQUAL(server.FindTopDocuments(""s, DocumentStatus::ACTUAL, 1000).size(), 150u);
+	for (int i = 0; i < server.GetDocumentCount(); ++i) {
+		ASSERT_EQUAL(server.GetDocumentId(i), 2 * i + 1);
+	}
+	server.AddDocument(4, " "s, DocumentStatus::ACTUAL, { 1 });
+	ASSERT_EQUAL(server.FindTopDocuments(""s).size(), 1u);
+}
+
+void TestLoadDocuments()
+{
+	SearchServer server(" "s);
+	stringstream input;
+	input << "1\t0\t8 -3\t    \r\n"s
+		<< "\n"s
+		<< "2\t2\t7 2 7\t   \n"s
+		<< "3\t0\t\t   "s;
+	//  ,     
+	ASSERT_EQUAL(LoadDocuments(input, server, 8), 3u);
+	ASSERT_EQUAL(server.GetDocumentCount(), 3);
+	const auto documents = server.FindTopDocuments(""s);
+	ASSERT_EQUAL(documents.size(), 1u);
+	ASSERT_EQUAL(documents[0].id, 1);
+	ASSERT_EQUAL(documents[0].rating, 2);
+	ASSERT_EQUAL(server.FindTopDocuments(""s, DocumentStatus::BANNED)[0].id, 2);
+	ASSERT_EQUAL(server.FindTopDocuments(""s)[0].rating, 0);
+	ASSERT_EQUAL(server.GetWordFrequencies(1).size(), 4u);
+
+	stringstream broken("4\t0\t1 x\t\n"s);
+	try {
+		LoadDocuments(broken, server);
+		ASSERT_HINT(false, "bad rating was accepted"s);
+	}
+	catch (const invalid_argument&) {
+	}
+	ASSERT_EQUAL(server.GetDocumentCount(), 3);
+}
+
+void TestStopWordSet()
+{
+	set<string, less<>> words;
+	for (int i = 0; i < 1000; ++i) {
+		words.insert(""s + to_string(i * 7));
+	}
+	const StopWordSet stop_words(words);
+	ASSERT_EQUAL(stop_words.size(), words.size());
+	ASSERT(equal(stop_words.begin(), stop_words.end(), words.begin(), words.end()));
+	for (int i = 0; i < 7000; ++i) {
+		ASSERT_EQUAL(stop_words.Contains(""s + to_string(i)), i % 7 == 0);
+	}
+	ASSERT(!stop_words.Contains(""sv));
+	ASSERT(!StopWordSet().Contains("0"sv));
+
+	SearchServer server("  "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 1 });
+	ASSERT_EQUAL(server.GetWordFrequencies(1).size(), 3u);
+	ASSERT(server.FindTopDocuments(" "s).empty());
+}
+
+void TestSplitIntoWordsWithControlChars()
+{
+	//    SSE2  AVX2,    ,   
+	mt19937 generator(7);
+	const string alphabet = "ab  \xE0\xFF"s + '\x01' + '\x1F';
+	for (int n = 0; n < 500; ++n) {
+		string text(generator() % 100, ' ');
+		for (char& c : text) {
+			c = alphabet[generator() % (n % 2 == 0 ? 6 : alphabet.size())];
+		}
+		vector<string_view> expected;
+		string_view expected_invalid;
+		size_t word_begin = 0;
+		for (size_t i = 0; i <= text.size(); ++i) {
+			if (i == text.size() || text[i] == ' ') {
+				const string_view word = string_view(text).substr(word_begin, i - word_begin);
+				if (!word.empty()) {
+					expected.push_back(word);
+					if (expected_invalid.empty() && any_of(word.begin(), word.end(), [](char c) {
+						return static_cast<unsigned char>(c) < ' ';
+						})) {
+						expected_invalid = word;
+					}
+				}
+				word_begin = i + 1;
+			}
+		}
+		pmr::vector<string_view> words;
+		const string_view invalid = SplitIntoWords(text, words);
+		ASSERT(equal(words.begin(), words.end(), expected.begin(), expected.end()));
+		ASSERT(invalid == expected_invalid);
+		ASSERT(invalid.data() == expected_invalid.data() || expected_invalid.empty());
+	}
+
+	SearchServer server(""s);
+	try {
+		server.AddDocument(1, "    \x02    "s, DocumentStatus::ACTUAL, { 1 });
+		ASSERT_HINT(false, "control character was accepted"s);
+	}
+	catch (const invalid_argument&) {
+	}
+	ASSERT_EQUAL(server.GetDocumentCount(), 0);
+}
+
+void TestQueryArena()
+{
+	{
+		QueryArena arena;
+		//    :    
+		pmr::vector<int> numbers(arena.GetResource());
+		for (int i = 0; i < 100000; ++i) {
+			numbers.push_back(i);
+		}
+		ASSERT_EQUAL(numbers.back(), 99999);
+		QueryArena nested;
+		pmr::map<int, double> scratch(nested.GetResource());
+		scratch[1] = 1.0;
+		ASSERT_EQUAL(scratch.size(), 1u);
+	}
+
+	SearchServer server(" "s);
+	server.AddDocument(1, "    "s, DocumentStatus::ACTUAL, { 8, -3 });
+	server.AddDocument(2, "   "s, DocumentStatus::ACTUAL, { 7, 2, 7 });
+	//     ,      
+	const auto result = server.FindTopDocuments(" -"s, [&server](int document_id, DocumentStatus, int) {
+		return !server.FindTopDocuments(""s).empty() && document_id > 0;
+	});
+	ASSERT_EQUAL(result.size(), 1u);
+	ASSERT_EQUAL(result[0].id, 2);
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQUAL(server.FindTopDocuments(execution::par, " "s).size(), 2u);
+	}
+}
+
 //  TestSearchServer      
 void TestSearchServer() {
 	RUN_TEST(TestExcludeMinusWordsFromAddedDocumentContent);
@@ -439,13 +1353,44 @@ void TestSearchServer() {
 	RUN_TEST(TestPredicate);
 	RUN_TEST(TestStatus);
 	RUN_TEST(TestRelevance);
+	RUN_TEST(TestParallelFindTopDocuments);
+	RUN_TEST(TestProcessQueries);
+	RUN_TEST(TestUnorderedDocumentIds);
+	RUN_TEST(TestRepeatedQueryWords);
+	RUN_TEST(TestRemoveDocument);
+	RUN_TEST(TestRemoveLeavesNoTracesInResults);
+	RUN_TEST(TestCopySearchServer);
+	RUN_TEST(TestGetDocumentIdAfterRemove);
+	RUN_TEST(TestCompactOrdinals);
+	RUN_TEST(TestConcurrentMap);
+	RUN_TEST(TestTopDocumentsCount);
+	RUN_TEST(TestInverseDocumentFreqAfterRemove);
+	RUN_TEST(TestAddDocuments);
+	RUN_TEST(TestSaveLoad);
+	RUN_TEST(TestLoadRejectsBrokenSnapshots);
+	RUN_TEST(TestSnapshotIndex);
+	RUN_TEST(TestCompressPostingLists);
+	RUN_TEST(TestMinusWordsOnLongPostingLists);
+	RUN_TEST(TestParallelMatchDocument);
+	RUN_TEST(TestQueryCache);
+	RUN_TEST(TestRequestQueueWindow);
+	RUN_TEST(TestConcurrentRequestQueue);
+	RUN_TEST(TestPaginator);
+	RUN_TEST(TestSearchCursor);
+	RUN_TEST(TestSearchCursorNearlyEqualRelevance);
+	RUN_TEST(TestRemoveDuplicates);
+	RUN_TEST(TestRemoveDocuments);
+	RUN_TEST(TestLoadDocuments);
+	RUN_TEST(TestStopWordSet);
+	RUN_TEST(TestSplitIntoWordsWithControlChars);
+	RUN_TEST(TestQueryArena);
 }
 
 // ---------      -----------
 
-*/
-
 int main() {
+	TestSearchServer();
+
 	SearchServer search_server("and in at"s);
 	RequestQueue request_queue(search_server);
 	search_server.AddDocument(1, "curly cat curly tail"s, DocumentStatus::ACTUAL, { 7, 2, 7 });
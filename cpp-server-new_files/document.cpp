@@ -1 +1,7 @@
 #include "document.h"
+
+using namespace std;
+
+ostream& operator<<(ostream& os, const Document& doc) {
+	return os << "{ document_id = "s << doc.id << ", relevance = "s << doc.relevance << ", rating = "s << doc.rating << " }"s;
+}
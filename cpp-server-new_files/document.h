@@ -1,25 +1,35 @@
 #pragma once
-class document
-{
-	struct Document {
-		Document() = default;
+#include <iostream>
+#include <string_view>
+#include <vector>
 
-		Document(int id_s, double relevance_s, int rating_s)
-			: id(id_s), relevance(relevance_s), rating(rating_s) {}
+struct Document {
+	Document() = default;
 
-		int id = 0;
-		double relevance = 0.0;
-		int rating = 0;
-	};
+	Document(int id_s, double relevance_s, int rating_s)
+		: id(id_s), relevance(relevance_s), rating(rating_s) {}
+
+	int id = 0;
+	double relevance = 0.0;
+	int rating = 0;
+};
 
 
 
-	enum class DocumentStatus {
-		ACTUAL,
-		IRRELEVANT,
-		BANNED,
-		REMOVED,
-	};
+enum class DocumentStatus {
+	ACTUAL,
+	IRRELEVANT,
+	BANNED,
+	REMOVED,
+};
 
+//      SearchServer::AddDocuments.
+// text   ,      .
+struct DocumentInput {
+	int id = 0;
+	std::string_view text;
+	DocumentStatus status = DocumentStatus::ACTUAL;
+	std::vector<int> ratings;
 };
 
+std::ostream& operator<<(std::ostream& os, const Document& doc);
@@ -1,5 +1,151 @@
 #pragma once
-class paginator
-{
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename Iterator>
+class IteratorRange {
+public:
+	IteratorRange(Iterator begin, Iterator end)
+		: begin_(begin), end_(end), size_(std::distance(begin, end)) {}
+
+	// size  ,      
+	IteratorRange(Iterator begin, Iterator end, size_t size)
+		: begin_(begin), end_(end), size_(size) {}
+
+	Iterator begin() const {
+		return begin_;
+	}
+
+	Iterator end() const {
+		return end_;
+	}
+
+	size_t size() const {
+		return size_;
+	}
+
+private:
+	Iterator begin_;
+	Iterator end_;
+	size_t size_;
+
+};
+
+//   ,    :  Paginator  O(1).
+//         O(1),
+//         .
+template <typename Iterator>
+class Paginator {
+	static constexpr bool IS_RANDOM_ACCESS = std::is_base_of_v<std::random_access_iterator_tag,
+		typename std::iterator_traits<Iterator>::iterator_category>;
+
+public:
+	class PageIterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = IteratorRange<Iterator>;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const value_type*;
+		using reference = const value_type&;
+
+		PageIterator(Iterator page_begin, Iterator end, size_t page_size)
+			: page_(MakePage(page_begin, end, page_size)), end_(end), page_size_(page_size) {}
+
+		reference operator*() const {
+			return page_;
+		}
+
+		pointer operator->() const {
+			return &page_;
+		}
+
+		PageIterator& operator++() {
+			page_ = MakePage(page_.end(), end_, page_size_);
+			return *this;
+		}
+
+		PageIterator operator++(int) {
+			PageIterator old = *this;
+			++*this;
+			return old;
+		}
+
+		bool operator==(const PageIterator& other) const {
+			return page_.begin() == other.page_.begin();
+		}
+
+		bool operator!=(const PageIterator& other) const {
+			return !(*this == other);
+		}
+
+	private:
+		IteratorRange<Iterator> page_;
+		Iterator end_;
+		size_t page_size_;
+	};
+
+	Paginator(Iterator begin, Iterator end, size_t page_size)
+		: begin_(begin), end_(end), page_size_(page_size) {
+		if (page_size == 0) {
+			throw std::invalid_argument("     0.");
+		}
+	}
+
+	PageIterator begin() const {
+		return PageIterator(begin_, end_, page_size_);
+	}
+
+	PageIterator end() const {
+		return PageIterator(end_, end_, page_size_);
+	}
+
+	// O(1)    ,    
+	size_t size() const {
+		const size_t item_count = std::distance(begin_, end_);
+		return (item_count + page_size_ - 1) / page_size_;
+	}
+
+	//     ; page < size()
+	IteratorRange<Iterator> operator[](size_t page) const {
+		static_assert(IS_RANDOM_ACCESS, "random access to pages needs random access iterators");
+		return MakePage(begin_ + page * page_size_, end_, page_size_);
+	}
+
+private:
+	Iterator begin_;
+	Iterator end_;
+	size_t page_size_;
+
+	//      page_size ,   page_begin
+	static IteratorRange<Iterator> MakePage(Iterator page_begin, Iterator end, size_t page_size) {
+		if constexpr (IS_RANDOM_ACCESS) {
+			const size_t size = std::min<size_t>(page_size, end - page_begin);
+			return IteratorRange<Iterator>(page_begin, page_begin + size, size);
+		}
+		else {
+			Iterator page_end = page_begin;
+			size_t size = 0;
+			for (; size < page_size && page_end != end; ++size) {
+				++page_end;
+			}
+			return IteratorRange<Iterator>(page_begin, page_end, size);
+		}
+	}
 };
 
+template <typename Iterator>
+std::ostream& operator<< (std::ostream& out, const IteratorRange<Iterator>& range) {
+	for (Iterator it = range.begin(); it != range.end(); ++it) {
+		out << *it;
+	}
+	return out;
+}
+
+template <typename Container>
+auto Paginate(const Container& c, size_t page_size) {
+	return Paginator(c.begin(), c.end(), page_size);
+}
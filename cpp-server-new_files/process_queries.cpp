@@ -0,0 +1,45 @@
+#include "process_queries.h"
+
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <numeric>
+
+using namespace std;
+
+vector<vector<Document>> ProcessQueries(
+	const SearchServer& search_server,
+	const vector<string>& queries) {
+	vector<vector<Document>> result(queries.size());
+	transform(execution::par, queries.begin(), queries.end(), result.begin(),
+		[&search_server](const string& query) {
+			return search_server.FindTopDocuments(query);
+		});
+	return result;
+}
+
+vector<Document> ProcessQueriesJoined(
+	const SearchServer& search_server,
+	const vector<string>& queries) {
+	//       MAX_RESULT_DOCUMENT_COUNT ,
+	//          
+	vector<Document> joined(queries.size() * MAX_RESULT_DOCUMENT_COUNT);
+	vector<size_t> counts(queries.size());
+	vector<size_t> indexes(queries.size());
+	iota(indexes.begin(), indexes.end(), 0);
+	for_each(execution::par, indexes.begin(), indexes.end(),
+		[&](size_t i) {
+			const vector<Document> documents = search_server.FindTopDocuments(queries[i]);
+			copy(documents.begin(), documents.end(), joined.begin() + i * MAX_RESULT_DOCUMENT_COUNT);
+			counts[i] = documents.size();
+		});
+
+	//   ,    
+	auto output = joined.begin();
+	for (size_t i = 0; i < queries.size(); ++i) {
+		const auto slot = joined.begin() + i * MAX_RESULT_DOCUMENT_COUNT;
+		output = move(slot, slot + counts[i], output);
+	}
+	joined.erase(output, joined.end());
+	return joined;
+}
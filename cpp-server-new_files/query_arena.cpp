@@ -0,0 +1,71 @@
+#include "query_arena.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+	const size_t INITIAL_BUFFER_SIZE = 64 * 1024;
+	const size_t MAX_BUFFER_SIZE = 16 * 1024 * 1024;
+	const size_t NESTED_BUFFER_SIZE = 4 * 1024;
+
+	struct ThreadBuffer {
+		vector<byte> data;
+		// ,    ,    
+		size_t next_size = INITIAL_BUFFER_SIZE;
+		bool in_use = false;
+	};
+
+	thread_local ThreadBuffer thread_buffer;
+
+	span<byte> AcquireThreadBuffer() {
+		if (thread_buffer.in_use) {
+			return {};
+		}
+		thread_buffer.in_use = true;
+		//    ,        
+		if (thread_buffer.data.size() < thread_buffer.next_size) {
+			thread_buffer.data = vector<byte>(thread_buffer.next_size);
+		}
+		return thread_buffer.data;
+	}
+}
+
+QueryArena::QueryArena()
+	: thread_buffer_(AcquireThreadBuffer())
+	, nested_buffer_(thread_buffer_.empty() ? NESTED_BUFFER_SIZE : 0)
+	, resource_(thread_buffer_.empty() ? nested_buffer_.data() : thread_buffer_.data(),
+		thread_buffer_.empty() ? nested_buffer_.size() : thread_buffer_.size(), &overflow_) {
+
+}
+
+QueryArena::~QueryArena() {
+	if (thread_buffer_.empty()) {
+		return;
+	}
+	if (overflow_.GetAllocatedBytes() > 0) {
+		thread_buffer.next_size = min(MAX_BUFFER_SIZE, 2 * (thread_buffer_.size() + overflow_.GetAllocatedBytes()));
+	}
+	thread_buffer.in_use = false;
+}
+
+pmr::memory_resource* QueryArena::GetResource() {
+	return &resource_;
+}
+
+size_t QueryArena::OverflowResource::GetAllocatedBytes() const {
+	return allocated_bytes_;
+}
+
+void* QueryArena::OverflowResource::do_allocate(size_t bytes, size_t alignment) {
+	allocated_bytes_ += bytes;
+	return pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void QueryArena::OverflowResource::do_deallocate(void* memory, size_t bytes, size_t alignment) {
+	pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+}
+
+bool QueryArena::OverflowResource::do_is_equal(const pmr::memory_resource& other) const noexcept {
+	return this == &other;
+}
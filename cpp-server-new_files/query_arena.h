@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+//      :  ,  .
+//      ,     ,
+//           .   
+//  ,    ,      .
+//      (,   )   .
+//   :      .
+class QueryArena {
+public:
+	QueryArena();
+
+	~QueryArena();
+
+	QueryArena(const QueryArena&) = delete;
+	QueryArena& operator=(const QueryArena&) = delete;
+
+	std::pmr::memory_resource* GetResource();
+
+private:
+	//      ,     
+	class OverflowResource : public std::pmr::memory_resource {
+	public:
+		size_t GetAllocatedBytes() const;
+
+	private:
+		size_t allocated_bytes_ = 0;
+
+		void* do_allocate(size_t bytes, size_t alignment) override;
+
+		void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+	};
+
+	OverflowResource overflow_;
+	//  ; ,      
+	std::span<std::byte> thread_buffer_;
+	std::vector<std::byte> nested_buffer_;
+	std::pmr::monotonic_buffer_resource resource_;
+};
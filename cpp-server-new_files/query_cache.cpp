@@ -0,0 +1,74 @@
+#include "query_cache.h"
+
+using namespace std;
+
+QueryCache::QueryCache(const SearchServer& search_server, size_t capacity)
+	: search_server_(search_server)
+	, capacity_(capacity)
+	, generation_(search_server.GetGeneration()) {
+
+}
+
+vector<Document> QueryCache::FindTopDocuments(string_view raw_query) {
+	return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
+}
+
+vector<Document> QueryCache::FindTopDocuments(string_view raw_query, DocumentStatus status, size_t max_count) {
+	string key = MakeKey(raw_query, "status:"sv, to_string(static_cast<int>(status)), max_count);
+	if (const vector<Document>* cached = Find(key)) {
+		return *cached;
+	}
+	vector<Document> result = search_server_.FindTopDocuments(raw_query, status, max_count);
+	Insert(move(key), result);
+	return result;
+}
+
+int QueryCache::GetHitCount() const {
+	return hits_;
+}
+
+int QueryCache::GetMissCount() const {
+	return misses_;
+}
+
+size_t QueryCache::GetSize() const {
+	return entries_.size();
+}
+
+string QueryCache::MakeKey(string_view raw_query, string_view filter_kind, string_view filter,
+	size_t max_count) const {
+	// '\n'     ,     
+	string key = search_server_.GetNormalizedQuery(raw_query);
+	key.push_back('\n');
+	key.append(filter_kind).append(filter).push_back('\n');
+	key.append(to_string(max_count));
+	return key;
+}
+
+const vector<Document>* QueryCache::Find(const string& key) {
+	if (generation_ != search_server_.GetGeneration()) {
+		key_to_entry_.clear();
+		entries_.clear();
+		generation_ = search_server_.GetGeneration();
+	}
+	const auto it = key_to_entry_.find(key);
+	if (it == key_to_entry_.end()) {
+		++misses_;
+		return nullptr;
+	}
+	++hits_;
+	entries_.splice(entries_.begin(), entries_, it->second);
+	return &it->second->second;
+}
+
+void QueryCache::Insert(string key, const vector<Document>& documents) {
+	if (capacity_ == 0) {
+		return;
+	}
+	if (entries_.size() == capacity_) {
+		key_to_entry_.erase(entries_.back().first);
+		entries_.pop_back();
+	}
+	entries_.emplace_front(move(key), documents);
+	key_to_entry_.emplace(entries_.front().first, entries_.begin());
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "search_server.h"
+
+//   FindTopDocuments  SearchServer.    capacity 
+//   ,       (LRU).  -  
+// ,   max_count,  " -"  "  - "   .
+//     (SearchServer::GetGeneration)   .
+class QueryCache {
+public:
+	QueryCache(const SearchServer& search_server, size_t capacity);
+
+	std::vector<Document> FindTopDocuments(std::string_view raw_query);
+
+	std::vector<Document> FindTopDocuments(std::string_view raw_query, DocumentStatus status,
+		size_t max_count = MAX_RESULT_DOCUMENT_COUNT);
+
+	//     ,    predicate_tag:
+	//      .
+	template <typename DocumentPredicate>
+	std::vector<Document> FindTopDocuments(std::string_view raw_query, std::string_view predicate_tag,
+		DocumentPredicate document_predicate, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) {
+		std::string key = MakeKey(raw_query, "predicate:", predicate_tag, max_count);
+		if (const std::vector<Document>* cached = Find(key)) {
+			return *cached;
+		}
+		std::vector<Document> result = search_server_.FindTopDocuments(raw_query, document_predicate, max_count);
+		Insert(std::move(key), result);
+		return result;
+	}
+
+	int GetHitCount() const;
+
+	int GetMissCount() const;
+
+	size_t GetSize() const;
+
+private:
+	using Entries = std::list<std::pair<std::string, std::vector<Document>>>;
+
+	const SearchServer& search_server_;
+	const size_t capacity_;
+	//     
+	Entries entries_;
+	std::unordered_map<std::string_view, Entries::iterator> key_to_entry_;
+	uint64_t generation_;
+	int hits_ = 0;
+	int misses_ = 0;
+
+	std::string MakeKey(std::string_view raw_query, std::string_view filter_kind, std::string_view filter,
+		size_t max_count) const;
+
+	//     nullptr.     Insert.
+	const std::vector<Document>* Find(const std::string& key);
+
+	void Insert(std::string key, const std::vector<Document>& documents);
+};
@@ -1,19 +1,121 @@
 #include "read_input_functions.h"
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
 
-{
-	using namespace std;
-	string ReadLine() {
-		string s;
-		getline(cin, s);
-		return s;
+using namespace std;
+
+string ReadLine() {
+	string s;
+	getline(cin, s);
+	return s;
+}
+
+int ReadLineWithNumber() {
+	int result;
+	cin >> result;
+	ReadLine();
+	return result;
+}
+
+namespace {
+	[[noreturn]] void ThrowInvalidLine(size_t line_number, const string& reason) {
+		throw invalid_argument(" "s + to_string(line_number) + ": "s + reason);
+	}
+
+	int ParseNumber(string_view text, size_t line_number) {
+		int value = 0;
+		const char* const end = text.data() + text.size();
+		const auto [parsed_end, error] = from_chars(text.data(), end, value);
+		if (error != errc{} || parsed_end != end) {
+			ThrowInvalidLine(line_number, "  \""s + string(text) + "\""s);
+		}
+		return value;
 	}
 
-	int ReadLineWithNumber() {
-		int result;
-		cin >> result;
-		ReadLine();
-		return result;
+	//   line   
+	string_view TakeField(string_view& line, size_t line_number) {
+		const size_t tab = line.find('\t');
+		if (tab == string_view::npos) {
+			ThrowInvalidLine(line_number, " 4   "s);
+		}
+		const string_view field = line.substr(0, tab);
+		line.remove_prefix(tab + 1);
+		return field;
+	}
+
+	DocumentInput ParseDocumentLine(string_view line, size_t line_number) {
+		DocumentInput document;
+		document.id = ParseNumber(TakeField(line, line_number), line_number);
+		const int status = ParseNumber(TakeField(line, line_number), line_number);
+		if (status < static_cast<int>(DocumentStatus::ACTUAL) || status > static_cast<int>(DocumentStatus::REMOVED)) {
+			ThrowInvalidLine(line_number, "  "s + to_string(status));
+		}
+		document.status = static_cast<DocumentStatus>(status);
+		string_view ratings = TakeField(line, line_number);
+		while (!ratings.empty()) {
+			const size_t space = min(ratings.find(' '), ratings.size());
+			if (space > 0) {
+				document.ratings.push_back(ParseNumber(ratings.substr(0, space), line_number));
+			}
+			ratings.remove_prefix(min(space + 1, ratings.size()));
+		}
+		document.text = line;
+		return document;
+	}
+}
+
+size_t LoadDocuments(istream& input, SearchServer& search_server, size_t chunk_size) {
+	vector<char> buffer(max<size_t>(chunk_size, 1));
+	size_t filled = 0;
+	size_t line_number = 0;
+	size_t loaded = 0;
+	vector<DocumentInput> batch;
+	bool at_end = false;
+	while (!at_end) {
+		//   :  ,    
+		if (filled == buffer.size()) {
+			buffer.resize(buffer.size() * 2);
+		}
+		input.read(buffer.data() + filled, buffer.size() - filled);
+		filled += static_cast<size_t>(input.gcount());
+		at_end = !input;
+
+		const string_view data(buffer.data(), filled);
+		size_t line_begin = 0;
+		while (line_begin < data.size()) {
+			size_t line_end = data.find('\n', line_begin);
+			if (line_end == string_view::npos) {
+				if (!at_end) {
+					break;
+				}
+				//     
+				line_end = data.size();
+			}
+			string_view line = data.substr(line_begin, line_end - line_begin);
+			++line_number;
+			if (!line.empty() && line.back() == '\r') {
+				line.remove_suffix(1);
+			}
+			if (!line.empty()) {
+				batch.push_back(ParseDocumentLine(line, line_number));
+			}
+			line_begin = min(line_end + 1, data.size());
+		}
+
+		//     ,    ,   
+		if (!batch.empty()) {
+			search_server.AddDocuments(batch);
+			loaded += batch.size();
+			batch.clear();
+		}
+		copy(buffer.begin() + line_begin, buffer.begin() + filled, buffer.begin());
+		filled -= line_begin;
 	}
+	return loaded;
 }
@@ -1,12 +1,17 @@
 #pragma once
+#include <iostream>
 #include <string>
 
-class read_input_functions
-{
+#include "search_server.h"
 
+std::string ReadLine();
 
-	std::string ReadLine();
-
-	int ReadLineWithNumber();
-};
+int ReadLineWithNumber();
 
+//  ,    : "id<TAB><TAB>  <TAB>",
+//  -   DocumentStatus.     chunk_size , 
+//              
+//  AddDocuments.   , "\r\n" .
+//    .     invalid_argument
+//   ;        .
+size_t LoadDocuments(std::istream& input, SearchServer& search_server, size_t chunk_size = 1 << 20);
@@ -0,0 +1,59 @@
+#include "remove_duplicates.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+namespace {
+	uint64_t ComputeWordSetFingerprint(const map<string_view, double>& word_freqs) {
+		uint64_t fingerprint = word_freqs.size();
+		for (const auto& [word, _] : word_freqs) {
+			fingerprint = fingerprint * 1099511628211ULL ^ hash<string_view>{}(word);
+		}
+		return fingerprint;
+	}
+
+	bool HaveSameWords(const map<string_view, double>& lhs, const map<string_view, double>& rhs) {
+		return lhs.size() == rhs.size() && equal(lhs.begin(), lhs.end(), rhs.begin(),
+			[](const auto& lhs_word, const auto& rhs_word) {
+				return lhs_word.first == rhs_word.first;
+			});
+	}
+}
+
+vector<int> RemoveDuplicates(SearchServer& search_server) {
+	vector<int> document_ids;
+	document_ids.reserve(search_server.GetDocumentCount());
+	for (int i = 0; i < search_server.GetDocumentCount(); ++i) {
+		document_ids.push_back(search_server.GetDocumentId(i));
+	}
+	//     id,    
+	sort(document_ids.begin(), document_ids.end());
+
+	//  ->     (     )
+	unordered_map<uint64_t, vector<int>> kept_documents;
+	vector<int> duplicates;
+	for (const int document_id : document_ids) {
+		const map<string_view, double> word_freqs = search_server.GetWordFrequencies(document_id);
+		vector<int>& same_fingerprint = kept_documents[ComputeWordSetFingerprint(word_freqs)];
+		const bool is_duplicate = any_of(same_fingerprint.begin(), same_fingerprint.end(),
+			[&](int kept_id) {
+				return HaveSameWords(search_server.GetWordFrequencies(kept_id), word_freqs);
+			});
+		if (is_duplicate) {
+			duplicates.push_back(document_id);
+		}
+		else {
+			same_fingerprint.push_back(document_id);
+		}
+	}
+
+	search_server.RemoveDocuments(duplicates);
+	return duplicates;
+}
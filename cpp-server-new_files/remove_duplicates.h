@@ -0,0 +1,11 @@
+#pragma once
+#include <vector>
+
+#include "search_server.h"
+
+//  ,           id,
+//    id  .    -   .
+//     ( ),  -    ,
+//      RemoveDocuments,    
+// O(  )     .
+std::vector<int> RemoveDuplicates(SearchServer& search_server);
@@ -1 +1,198 @@
 #include "request_queue.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void RequestStats::Record(size_t result_size, chrono::microseconds latency) {
+	++requests;
+	if (result_size == 0) {
+		++no_result;
+	}
+	++result_sizes[min(result_size, RESULT_SIZE_BUCKETS - 1)];
+	size_t latency_bucket = 0;
+	while (latency_bucket + 1 < LATENCY_BUCKETS && latency.count() >= (int64_t{ 1 } << latency_bucket)) {
+		++latency_bucket;
+	}
+	++latencies[latency_bucket];
+}
+
+RequestStats& RequestStats::operator+=(const RequestStats& other) {
+	requests += other.requests;
+	no_result += other.no_result;
+	for (size_t i = 0; i < RESULT_SIZE_BUCKETS; ++i) {
+		result_sizes[i] += other.result_sizes[i];
+	}
+	for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+		latencies[i] += other.latencies[i];
+	}
+	return *this;
+}
+
+RequestStats& RequestStats::operator-=(const RequestStats& other) {
+	requests -= other.requests;
+	no_result -= other.no_result;
+	for (size_t i = 0; i < RESULT_SIZE_BUCKETS; ++i) {
+		result_sizes[i] -= other.result_sizes[i];
+	}
+	for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+		latencies[i] -= other.latencies[i];
+	}
+	return *this;
+}
+
+chrono::microseconds RequestStats::GetLatencyPercentile(double percentile) const {
+	const double rank = percentile * requests;
+	int seen = 0;
+	for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+		seen += latencies[i];
+		if (seen > 0 && seen >= rank) {
+			return chrono::microseconds(int64_t{ 1 } << i);
+		}
+	}
+	return chrono::microseconds(0);
+}
+
+RequestWindow::RequestWindow()
+	: slots_(MINUTES_IN_DAY) {
+
+}
+
+void RequestWindow::Record(int64_t minute, size_t result_size, chrono::microseconds latency) {
+	AdvanceTo(minute);
+	if (minute <= current_minute_ - MINUTES_IN_DAY) {
+		return;
+	}
+	slots_[minute % MINUTES_IN_DAY].stats.Record(result_size, latency);
+	totals_.Record(result_size, latency);
+}
+
+void RequestWindow::AdvanceTo(int64_t minute) {
+	// ,   , ;     
+	const int64_t first = max(current_minute_ + 1, minute - MINUTES_IN_DAY + 1);
+	for (int64_t m = first; m <= minute; ++m) {
+		Slot& slot = slots_[m % MINUTES_IN_DAY];
+		totals_ -= slot.stats;
+		slot = { m, RequestStats{} };
+	}
+	current_minute_ = max(current_minute_, minute);
+}
+
+const RequestStats& RequestWindow::GetTotals() const {
+	return totals_;
+}
+
+RequestQueue::RequestQueue(const SearchServer& search_server)
+	: search_server_(search_server) {
+
+}
+
+RequestQueue::RequestQueue(const SearchServer& search_server, Clock now)
+	: search_server_(search_server)
+	, now_(move(now))
+	, start_(now_()) {
+
+}
+
+vector<Document> RequestQueue::AddFindRequest(const string& raw_query, DocumentStatus status) {
+	return AddFindRequest(raw_query, [status](int document_id, DocumentStatus status_, int rating) { return status_ == status; });
+}
+
+vector<Document> RequestQueue::AddFindRequest(const string& raw_query) {
+	return AddFindRequest(raw_query, DocumentStatus::ACTUAL);
+}
+
+int RequestQueue::GetNoResultRequests() const {
+	return GetCurrentTotals().no_result;
+}
+
+int RequestQueue::GetRequestCount() const {
+	return GetCurrentTotals().requests;
+}
+
+RequestStats RequestQueue::GetStats() const {
+	return GetCurrentTotals();
+}
+
+chrono::microseconds RequestQueue::GetLatencyPercentile(double percentile) const {
+	return GetCurrentTotals().GetLatencyPercentile(percentile);
+}
+
+int64_t RequestQueue::NextMinute() {
+	if (now_) {
+		return chrono::duration_cast<chrono::minutes>(now_() - start_).count();
+	}
+	return request_count_++;
+}
+
+const RequestStats& RequestQueue::GetCurrentTotals() const {
+	if (now_) {
+		window_.AdvanceTo(chrono::duration_cast<chrono::minutes>(now_() - start_).count());
+	}
+	return window_.GetTotals();
+}
+
+ConcurrentRequestQueue::ConcurrentRequestQueue(const SearchServer& search_server)
+	: ConcurrentRequestQueue(search_server, nullptr) {
+
+}
+
+ConcurrentRequestQueue::ConcurrentRequestQueue(const SearchServer& search_server, RequestQueue::Clock now)
+	//  ,       
+	: ConcurrentRequestQueue(search_server, move(now), max(1u, thread::hardware_concurrency()) * 4) {
+
+}
+
+ConcurrentRequestQueue::ConcurrentRequestQueue(const SearchServer& search_server, RequestQueue::Clock now,
+	size_t shard_count)
+	: search_server_(search_server)
+	, now_(move(now))
+	, start_(now_ ? now_() : chrono::steady_clock::time_point{})
+	, shards_(max<size_t>(shard_count, 1)) {
+
+}
+
+vector<Document> ConcurrentRequestQueue::AddFindRequest(const string& raw_query, DocumentStatus status) {
+	return AddFindRequest(raw_query, [status](int document_id, DocumentStatus status_, int rating) { return status_ == status; });
+}
+
+vector<Document> ConcurrentRequestQueue::AddFindRequest(const string& raw_query) {
+	return AddFindRequest(raw_query, DocumentStatus::ACTUAL);
+}
+
+int ConcurrentRequestQueue::GetNoResultRequests() const {
+	return GetStats().no_result;
+}
+
+int ConcurrentRequestQueue::GetRequestCount() const {
+	return GetStats().requests;
+}
+
+RequestStats ConcurrentRequestQueue::GetStats() const {
+	//      ,        
+	const int64_t minute = now_
+		? chrono::duration_cast<chrono::minutes>(now_() - start_).count()
+		: request_count_.load() - 1;
+	RequestStats result;
+	for (Shard& shard : shards_) {
+		lock_guard<mutex> guard(shard.mutex);
+		shard.window.AdvanceTo(minute);
+		result += shard.window.GetTotals();
+	}
+	return result;
+}
+
+chrono::microseconds ConcurrentRequestQueue::GetLatencyPercentile(double percentile) const {
+	return GetStats().GetLatencyPercentile(percentile);
+}
+
+int64_t ConcurrentRequestQueue::NextMinute() {
+	if (now_) {
+		return chrono::duration_cast<chrono::minutes>(now_() - start_).count();
+	}
+	return request_count_++;
+}
+
+ConcurrentRequestQueue::Shard& ConcurrentRequestQueue::GetShard() {
+	return shards_[hash<thread::id>{}(this_thread::get_id()) % shards_.size()];
+}
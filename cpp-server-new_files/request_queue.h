@@ -1,5 +1,166 @@
 #pragma once
-class request_queue
-{
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "search_server.h"
+
+//  :   ,   ,
+//      .
+struct RequestStats {
+	//  i -   i ,  -  MAX_RESULT_DOCUMENT_COUNT  
+	static constexpr size_t RESULT_SIZE_BUCKETS = MAX_RESULT_DOCUMENT_COUNT + 1;
+	//  i -   2^i ,  -   ( 2 )
+	static constexpr size_t LATENCY_BUCKETS = 23;
+
+	int requests = 0;
+	int no_result = 0;
+	std::array<int, RESULT_SIZE_BUCKETS> result_sizes{};
+	std::array<int, LATENCY_BUCKETS> latencies{};
+
+	void Record(size_t result_size, std::chrono::microseconds latency);
+
+	RequestStats& operator+=(const RequestStats& other);
+
+	RequestStats& operator-=(const RequestStats& other);
+
+	//   ,     percentile ( 0  1) .
+	//  -   ,     .
+	std::chrono::microseconds GetLatencyPercentile(double percentile) const;
+};
+
+//    MINUTES_IN_DAY :      .
+//     ,      O(1) ,
+//       .
+class RequestWindow {
+public:
+	static constexpr int MINUTES_IN_DAY = 1440;
+
+	RequestWindow();
+
+	//     .
+	void Record(int64_t minute, size_t result_size, std::chrono::microseconds latency);
+
+	//   ,     minute.    .
+	void AdvanceTo(int64_t minute);
+
+	const RequestStats& GetTotals() const;
+
+private:
+	struct Slot {
+		int64_t minute = -1;
+		RequestStats stats;
+	};
+
+	std::vector<Slot> slots_;
+	RequestStats totals_;
+	int64_t current_minute_ = -1;
 };
 
+class RequestQueue {
+public:
+	using Clock = std::function<std::chrono::steady_clock::time_point()>;
+
+	//     :  -  MINUTES_IN_DAY .
+	explicit RequestQueue(const SearchServer& search_server);
+
+	//     now    .
+	RequestQueue(const SearchServer& search_server, Clock now);
+
+	//  ""    ,      
+	template <typename DocumentPredicate>
+	std::vector<Document> AddFindRequest(const std::string& raw_query, DocumentPredicate document_predicate) {
+		const auto start = std::chrono::steady_clock::now();
+		auto result = search_server_.FindTopDocuments(raw_query, document_predicate);
+		const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start);
+		window_.Record(NextMinute(), result.size(), latency);
+		return result;
+	}
+
+	std::vector<Document> AddFindRequest(const std::string& raw_query, DocumentStatus status);
+
+	std::vector<Document> AddFindRequest(const std::string& raw_query);
+
+	int GetNoResultRequests() const;
+
+	int GetRequestCount() const;
+
+	//  ,      
+	RequestStats GetStats() const;
+
+	std::chrono::microseconds GetLatencyPercentile(double percentile) const;
+
+private:
+	const SearchServer& search_server_;
+	Clock now_;
+	std::chrono::steady_clock::time_point start_;
+	int64_t request_count_ = 0;
+	//       ,  -     
+	mutable RequestWindow window_;
+
+	int64_t NextMinute();
+
+	const RequestStats& GetCurrentTotals() const;
+};
+
+// RequestQueue   .    ,   
+//    shard_count ,   ,     .
+//    ,         .
+class ConcurrentRequestQueue {
+public:
+	explicit ConcurrentRequestQueue(const SearchServer& search_server);
+
+	// now   
+	ConcurrentRequestQueue(const SearchServer& search_server, RequestQueue::Clock now);
+
+	ConcurrentRequestQueue(const SearchServer& search_server, RequestQueue::Clock now, size_t shard_count);
+
+	// document_predicate      
+	template <typename DocumentPredicate>
+	std::vector<Document> AddFindRequest(const std::string& raw_query, DocumentPredicate document_predicate) {
+		const auto start = std::chrono::steady_clock::now();
+		auto result = search_server_.FindTopDocuments(raw_query, document_predicate);
+		const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now() - start);
+		const int64_t minute = NextMinute();
+		Shard& shard = GetShard();
+		std::lock_guard<std::mutex> guard(shard.mutex);
+		shard.window.Record(minute, result.size(), latency);
+		return result;
+	}
+
+	std::vector<Document> AddFindRequest(const std::string& raw_query, DocumentStatus status);
+
+	std::vector<Document> AddFindRequest(const std::string& raw_query);
+
+	int GetNoResultRequests() const;
+
+	int GetRequestCount() const;
+
+	RequestStats GetStats() const;
+
+	std::chrono::microseconds GetLatencyPercentile(double percentile) const;
+
+private:
+	struct Shard {
+		std::mutex mutex;
+		RequestWindow window;
+	};
+
+	const SearchServer& search_server_;
+	RequestQueue::Clock now_;
+	std::chrono::steady_clock::time_point start_;
+	std::atomic<int64_t> request_count_ = 0;
+	mutable std::vector<Shard> shards_;
+
+	int64_t NextMinute();
+
+	Shard& GetShard();
+};
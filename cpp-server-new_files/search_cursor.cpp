@@ -0,0 +1,95 @@
+#include "search_cursor.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace {
+	// True,   lhs    rhs.   :
+	//   EPSILON  ,     
+	//      .
+	bool IsRankedBefore(double lhs_relevance, int lhs_rating, int lhs_id,
+		double rhs_relevance, int rhs_rating, int rhs_id) {
+		if (lhs_relevance != rhs_relevance) {
+			return lhs_relevance > rhs_relevance;
+		}
+		if (lhs_rating != rhs_rating) {
+			return lhs_rating > rhs_rating;
+		}
+		return lhs_id < rhs_id;
+	}
+
+	//  : "" ,    
+	bool IsRankedAfter(const Document& lhs, const Document& rhs) {
+		return IsRankedBefore(rhs.relevance, rhs.rating, rhs.id, lhs.relevance, lhs.rating, lhs.id);
+	}
+}
+
+SearchCursor::SearchCursor(const SearchServer& search_server, string raw_query, DocumentStatus status)
+	: SearchCursor(search_server, move(raw_query),
+		[status](int document_id, DocumentStatus status_, int rating) { return status_ == status; }) {
+
+}
+
+SearchCursor::SearchCursor(const SearchServer& search_server, string raw_query, DocumentPredicate document_predicate)
+	: search_server_(search_server)
+	, raw_query_(move(raw_query))
+	, document_predicate_(move(document_predicate)) {
+	Refill();
+}
+
+SearchCursor::SearchCursor(const SearchServer& search_server, string raw_query, DocumentPredicate document_predicate,
+	ContinuationToken after)
+	: search_server_(search_server)
+	, raw_query_(move(raw_query))
+	, document_predicate_(move(document_predicate))
+	, last_(after) {
+	Refill();
+}
+
+vector<Document> SearchCursor::NextPage(size_t page_size) {
+	if (generation_ != search_server_.GetGeneration()) {
+		Refill();
+	}
+	vector<Document> page;
+	page.reserve(min(page_size, candidates_.size()));
+	while (page.size() < page_size && !candidates_.empty()) {
+		pop_heap(candidates_.begin(), candidates_.end(), IsRankedAfter);
+		page.push_back(candidates_.back());
+		candidates_.pop_back();
+	}
+	if (!page.empty()) {
+		last_ = ContinuationToken{ page.back().relevance, page.back().rating, page.back().id };
+	}
+	return page;
+}
+
+bool SearchCursor::HasMore() const {
+	return !candidates_.empty();
+}
+
+optional<SearchCursor::ContinuationToken> SearchCursor::GetToken() const {
+	return last_;
+}
+
+void SearchCursor::Refill() {
+	candidates_ = search_server_.FindMatchingDocuments(raw_query_, document_predicate_);
+	if (last_) {
+		//      IDF.     ,
+		//     ,  -   .
+		const auto last_it = find_if(candidates_.begin(), candidates_.end(), [this](const Document& document) {
+			return document.id == last_->id;
+		});
+		if (last_it != candidates_.end()) {
+			last_ = ContinuationToken{ last_it->relevance, last_it->rating, last_it->id };
+		}
+		const ContinuationToken last = *last_;
+		candidates_.erase(remove_if(candidates_.begin(), candidates_.end(), [&last](const Document& document) {
+			return !IsRankedBefore(last.relevance, last.rating, last.id,
+				document.relevance, document.rating, document.id);
+		}), candidates_.end());
+	}
+	make_heap(candidates_.begin(), candidates_.end(), IsRankedAfter);
+	generation_ = search_server_.GetGeneration();
+}
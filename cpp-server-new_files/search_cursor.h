@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "search_server.h"
+
+//       MAX_RESULT_DOCUMENT_COUNT.
+//         ,   
+//   page_size   O(page_size * log n)     .
+//  :   ,  ,    id.
+//   ,   FindTopDocuments   
+//   ,       EPSILON.
+//
+//    (SearchServer::GetGeneration),  ,
+//       .  
+// (ContinuationToken)       .
+class SearchCursor {
+public:
+	using DocumentPredicate = std::function<bool(int, DocumentStatus, int)>;
+
+	struct ContinuationToken {
+		double relevance = 0.0;
+		int rating = 0;
+		int id = 0;
+	};
+
+	SearchCursor(const SearchServer& search_server, std::string raw_query,
+		DocumentStatus status = DocumentStatus::ACTUAL);
+
+	SearchCursor(const SearchServer& search_server, std::string raw_query, DocumentPredicate document_predicate);
+
+	//  ,   
+	SearchCursor(const SearchServer& search_server, std::string raw_query, DocumentPredicate document_predicate,
+		ContinuationToken after);
+
+	//  page_size ;   -  
+	std::vector<Document> NextPage(size_t page_size);
+
+	bool HasMore() const;
+
+	//   ,    
+	std::optional<ContinuationToken> GetToken() const;
+
+private:
+	const SearchServer& search_server_;
+	std::string raw_query_;
+	DocumentPredicate document_predicate_;
+	std::optional<ContinuationToken> last_;
+	// ,   -  
+	std::vector<Document> candidates_;
+	uint64_t generation_ = 0;
+
+	void Refill();
+};
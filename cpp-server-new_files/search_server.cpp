@@ -1 +1,949 @@
 #include "search_server.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <unordered_set>
+
+#include "snapshot_index.h"
+
+using namespace std;
+
+SearchServer::SearchServer(const string& stop_words_text)
+	: SearchServer(string_view(stop_words_text)) {}
+
+SearchServer::SearchServer(string_view stop_words_text)
+	: SearchServer(
+		SplitIntoWords(stop_words_text)) {}
+
+SearchServer::SearchServer(const SearchServer& other)
+	: stop_words_(other.stop_words_)
+	, word_to_document_freqs_(other.word_to_document_freqs_)
+	, document_ordinals_(other.document_ordinals_)
+	, ordinal_to_document_id_(other.ordinal_to_document_id_)
+	, ratings_(other.ratings_)
+	, statuses_(other.statuses_)
+	, log_document_count_(other.log_document_count_)
+	, live_ordinals_(other.live_ordinals_)
+	, document_words_(other.document_words_)
+	, document_word_offsets_(other.document_word_offsets_) {
+	//      other;         
+	for (int ordinal = 0; ordinal < static_cast<int>(ordinal_to_document_id_.size()); ++ordinal) {
+		const bool is_live = IsLiveOrdinal(ordinal);
+		for (size_t i = document_word_offsets_[ordinal]; i < document_word_offsets_[ordinal + 1]; ++i) {
+			DocumentWord& document_word = document_words_[i];
+			document_word.word = is_live ? &*word_to_document_freqs_.find(document_word.word->first) : nullptr;
+		}
+	}
+}
+
+SearchServer& SearchServer::operator=(const SearchServer& other) {
+	if (this != &other) {
+		*this = SearchServer(other);
+	}
+	return *this;
+}
+
+void SearchServer::AddDocument(int document_id, string_view document, DocumentStatus status,
+	const vector<int>& ratings) {
+	if (document_id < 0)
+		throw invalid_argument("ID     0.");
+	if (document_ordinals_.count(document_id) != 0)
+		throw invalid_argument("   ID  .");
+	const TokenizedDocument tokenized = ComputeWordFreqs(document);
+	const int ordinal = static_cast<int>(ordinal_to_document_id_.size());
+	for (const auto& [word, term_freq] : tokenized.word_freqs) {
+		auto word_it = word_to_document_freqs_.find(word);
+		if (word_it == word_to_document_freqs_.end()) {
+			word_it = word_to_document_freqs_.emplace(string(word), PostingList{}).first;
+		}
+		word_it->second.Add(ordinal, term_freq);
+		document_words_.push_back({ &*word_it, term_freq });
+	}
+	document_word_offsets_.push_back(document_words_.size());
+	document_ordinals_.emplace(document_id, ordinal);
+	ordinal_to_document_id_.push_back(document_id);
+	ratings_.push_back(ComputeAverageRating(ratings));
+	statuses_.push_back(status);
+	log_document_count_ = log(GetDocumentCount());
+	generation_ = NextGeneration();
+	live_ordinals_.PushBack();
+}
+
+void SearchServer::AddDocuments(const vector<DocumentInput>& documents) {
+	AddDocuments(execution::par, documents);
+}
+
+SearchServer::TokenizedDocument SearchServer::ComputeWordFreqs(string_view text) const {
+	const pmr::vector<string_view> words = SplitIntoWordsNoStop(text);
+	const double inv_word_count = 1.0 / words.size();
+	TokenizedDocument result;
+	for (const string_view word : words) {
+		result.word_freqs[word] += inv_word_count;
+	}
+	return result;
+}
+
+SearchServer::TokenizedDocument SearchServer::TokenizeDocument(string_view text) const {
+	TokenizedDocument result;
+	try {
+		result = ComputeWordFreqs(text);
+	}
+	catch (const invalid_argument&) {
+		result.error = current_exception();
+	}
+	return result;
+}
+
+vector<SearchServer::BatchPosting> SearchServer::PrepareBatch(const vector<DocumentInput>& documents,
+	const vector<TokenizedDocument>& tokenized) const {
+	unordered_set<int> batch_ids;
+	size_t posting_count = 0;
+	for (size_t i = 0; i < documents.size(); ++i) {
+		const int document_id = documents[i].id;
+		if (document_id < 0)
+			throw invalid_argument("ID     0.");
+		if (document_ordinals_.count(document_id) != 0 || !batch_ids.insert(document_id).second)
+			throw invalid_argument("   ID  .");
+		if (tokenized[i].error) {
+			rethrow_exception(tokenized[i].error);
+		}
+		posting_count += tokenized[i].word_freqs.size();
+	}
+
+	vector<BatchPosting> postings;
+	postings.reserve(posting_count);
+	const int first_ordinal = static_cast<int>(ordinal_to_document_id_.size());
+	for (size_t i = 0; i < documents.size(); ++i) {
+		for (const auto& [word, term_freq] : tokenized[i].word_freqs) {
+			postings.push_back({ word, first_ordinal + static_cast<int>(i), term_freq });
+		}
+	}
+	return postings;
+}
+
+void SearchServer::MergeBatch(const vector<DocumentInput>& documents, const vector<BatchPosting>& postings) {
+	const int first_ordinal = static_cast<int>(ordinal_to_document_id_.size());
+	//        document_words_
+	vector<size_t> word_positions(documents.size(), 0);
+	for (const BatchPosting& posting : postings) {
+		++word_positions[posting.ordinal - first_ordinal];
+	}
+	size_t next_position = document_words_.size();
+	for (size_t& position : word_positions) {
+		next_position += exchange(position, next_position);
+	}
+	document_words_.resize(next_position);
+
+	//    ,      
+	//     
+	auto group_begin = postings.begin();
+	while (group_begin != postings.end()) {
+		const auto group_end = find_if(group_begin, postings.end(),
+			[word = group_begin->word](const BatchPosting& posting) { return posting.word != word; });
+		auto word_it = word_to_document_freqs_.find(group_begin->word);
+		if (word_it == word_to_document_freqs_.end()) {
+			word_it = word_to_document_freqs_.emplace(string(group_begin->word), PostingList{}).first;
+		}
+		PostingList& word_postings = word_it->second;
+		if (word_postings.IsCompressed()) {
+			word_postings.Decompress();
+		}
+		//     ,     
+		word_postings.ordinals.reserve(word_postings.size() + (group_end - group_begin));
+		word_postings.term_freqs.reserve(word_postings.size() + (group_end - group_begin));
+		for (auto it = group_begin; it != group_end; ++it) {
+			word_postings.ordinals.push_back(it->ordinal);
+			word_postings.term_freqs.push_back(it->term_freq);
+			document_words_[word_positions[it->ordinal - first_ordinal]++] = { &*word_it, it->term_freq };
+		}
+		word_postings.log_document_freq = log(word_postings.LiveSize());
+		group_begin = group_end;
+	}
+
+	for (size_t i = 0; i < documents.size(); ++i) {
+		const DocumentInput& document = documents[i];
+		document_word_offsets_.push_back(word_positions[i]);
+		document_ordinals_.emplace(document.id, first_ordinal + static_cast<int>(i));
+		ordinal_to_document_id_.push_back(document.id);
+		ratings_.push_back(ComputeAverageRating(document.ratings));
+		statuses_.push_back(document.status);
+		live_ordinals_.PushBack();
+	}
+	log_document_count_ = log(GetDocumentCount());
+	generation_ = NextGeneration();
+}
+
+vector<Document> SearchServer::FindTopDocuments(string_view raw_query) const
+{
+	return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
+}
+
+vector<Document> SearchServer::FindTopDocuments(string_view raw_query,
+	DocumentStatus status, size_t max_count) const {
+	return FindTopDocuments(raw_query, [status](int document_id, DocumentStatus status_, int rating) { return status_ == status; }, max_count);
+}
+
+int SearchServer::GetDocumentCount() const {
+	return document_ordinals_.size();
+}
+
+tuple<vector<string>, DocumentStatus> SearchServer::MatchDocument(string_view raw_query,
+	int document_id) const {
+	const auto [words, status] = MatchDocument(execution::seq, raw_query, document_id);
+	return { vector<string>(words.begin(), words.end()), status };
+}
+
+int SearchServer::GetDocumentId(int index) const {
+	if (index < 0 || index >= GetDocumentCount()) {
+		throw out_of_range("     ");
+	}
+	return ordinal_to_document_id_[live_ordinals_.Select(index)];
+}
+
+map<string_view, double> SearchServer::GetWordFrequencies(int document_id) const {
+	map<string_view, double> word_freqs;
+	const auto ordinal_it = document_ordinals_.find(document_id);
+	if (ordinal_it == document_ordinals_.end()) {
+		return word_freqs;
+	}
+	//    ,      O(1)
+	for (const DocumentWord* it = DocumentWordsBegin(ordinal_it->second); it != DocumentWordsEnd(ordinal_it->second); ++it) {
+		word_freqs.emplace_hint(word_freqs.end(), it->word->first, it->term_freq);
+	}
+	return word_freqs;
+}
+
+void SearchServer::RemoveDocument(int document_id) {
+	RemoveDocument(execution::seq, document_id);
+}
+
+void SearchServer::CompressPostingLists() {
+	for (auto& [_, postings] : word_to_document_freqs_) {
+		postings.Compress();
+	}
+}
+
+void SearchServer::EraseEmptyWords(const DocumentWord* begin, const DocumentWord* end) {
+	for (const DocumentWord* it = begin; it != end; ++it) {
+		if (it->word->second.LiveSize() == 0) {
+			word_to_document_freqs_.erase(word_to_document_freqs_.find(it->word->first));
+		}
+	}
+}
+
+void SearchServer::EraseDocumentRecord(int document_id) {
+	const auto ordinal_it = document_ordinals_.find(document_id);
+	ordinal_to_document_id_[ordinal_it->second] = REMOVED_DOCUMENT_ID;
+	live_ordinals_.Erase(ordinal_it->second);
+	document_ordinals_.erase(ordinal_it);
+}
+
+void SearchServer::FinishRemoval() {
+	log_document_count_ = log(GetDocumentCount());
+	generation_ = NextGeneration();
+	if (document_ordinals_.size() * 2 < ordinal_to_document_id_.size()) {
+		CompactOrdinals();
+	}
+}
+
+void SearchServer::RemoveDocuments(const vector<int>& document_ids) {
+	//    ,    
+	vector<WordPostings*> emptied_words;
+	bool removed = false;
+	for (const int document_id : document_ids) {
+		const auto ordinal_it = document_ordinals_.find(document_id);
+		if (ordinal_it == document_ordinals_.end()) {
+			continue;
+		}
+		const int ordinal = ordinal_it->second;
+		EraseDocumentRecord(document_id);
+		for (const DocumentWord* it = DocumentWordsBegin(ordinal); it != DocumentWordsEnd(ordinal); ++it) {
+			PostingList& postings = it->word->second;
+			postings.MarkRemoved([this](int removed_ordinal) { return !IsLiveOrdinal(removed_ordinal); });
+			if (postings.LiveSize() == 0) {
+				emptied_words.push_back(it->word);
+			}
+		}
+		removed = true;
+	}
+	if (!removed) {
+		return;
+	}
+	//      :       
+	for (WordPostings* word : emptied_words) {
+		word_to_document_freqs_.erase(word_to_document_freqs_.find(word->first));
+	}
+	FinishRemoval();
+}
+
+vector<int> SearchServer::MakeCompactOrdinals() const {
+	vector<int> new_ordinals(ordinal_to_document_id_.size(), -1);
+	int next_ordinal = 0;
+	for (int ordinal = 0; ordinal < static_cast<int>(new_ordinals.size()); ++ordinal) {
+		if (IsLiveOrdinal(ordinal)) {
+			new_ordinals[ordinal] = next_ordinal++;
+		}
+	}
+	return new_ordinals;
+}
+
+void SearchServer::CompactOrdinals() {
+	const vector<int> new_ordinals = MakeCompactOrdinals();
+	//    ,    
+	for (auto& [_, postings] : word_to_document_freqs_) {
+		const bool was_compressed = postings.IsCompressed();
+		postings.Decompress();
+		postings.RemoveIf([&new_ordinals](int ordinal) { return new_ordinals[ordinal] < 0; });
+		for (int& ordinal : postings.ordinals) {
+			ordinal = new_ordinals[ordinal];
+		}
+		if (was_compressed) {
+			postings.Compress();
+		}
+	}
+	for (auto& [_, ordinal] : document_ordinals_) {
+		ordinal = new_ordinals[ordinal];
+	}
+
+	size_t live_count = 0;
+	vector<size_t> word_offsets = { 0 };
+	word_offsets.reserve(document_ordinals_.size() + 1);
+	for (size_t ordinal = 0; ordinal < new_ordinals.size(); ++ordinal) {
+		if (new_ordinals[ordinal] >= 0) {
+			ordinal_to_document_id_[live_count] = ordinal_to_document_id_[ordinal];
+			ratings_[live_count] = ratings_[ordinal];
+			statuses_[live_count] = statuses_[ordinal];
+			//    ,      
+			const size_t words_begin = document_word_offsets_[ordinal];
+			const size_t words_end = document_word_offsets_[ordinal + 1];
+			copy(document_words_.begin() + words_begin, document_words_.begin() + words_end,
+				document_words_.begin() + word_offsets.back());
+			word_offsets.push_back(word_offsets.back() + (words_end - words_begin));
+			++live_count;
+		}
+	}
+	document_words_.resize(word_offsets.back());
+	document_words_.shrink_to_fit();
+	document_word_offsets_ = move(word_offsets);
+	ordinal_to_document_id_.resize(live_count);
+	ordinal_to_document_id_.shrink_to_fit();
+	ratings_.resize(live_count);
+	ratings_.shrink_to_fit();
+	statuses_.resize(live_count);
+	statuses_.shrink_to_fit();
+	live_ordinals_ = LiveOrdinals();
+	for (size_t ordinal = 0; ordinal < live_count; ++ordinal) {
+		live_ordinals_.PushBack();
+	}
+}
+
+void SearchServer::LiveOrdinals::PushBack() {
+	//  i   i - 1, i - 2, i - 4, ...  lowbit(i)
+	const size_t node = tree_.size() + 1;
+	int count = 1;
+	for (size_t child = 1; child < (node & (~node + 1)); child *= 2) {
+		count += tree_[node - child - 1];
+	}
+	tree_.push_back(count);
+}
+
+void SearchServer::LiveOrdinals::Erase(int ordinal) {
+	for (size_t node = ordinal + 1; node <= tree_.size(); node += node & (~node + 1)) {
+		--tree_[node - 1];
+	}
+}
+
+int SearchServer::LiveOrdinals::Select(int index) const {
+	size_t step = 1;
+	while (step * 2 <= tree_.size()) {
+		step *= 2;
+	}
+	//  node,      [1, node]   index
+	size_t node = 0;
+	int remaining = index;
+	for (; step > 0; step /= 2) {
+		if (node + step <= tree_.size() && tree_[node + step - 1] <= remaining) {
+			node += step;
+			remaining -= tree_[node - 1];
+		}
+	}
+	return static_cast<int>(node);
+}
+
+bool SearchServer::IsStopWord(string_view word) const {
+	return stop_words_.Contains(word);
+}
+
+pmr::vector<string_view> SearchServer::SplitIntoWordsNoStop(string_view text) const {
+	pmr::vector<string_view> words;
+	const string_view invalid_word = SplitIntoWords(text, words);
+	if (!invalid_word.empty()) {
+		//  invalid_argument   
+		CheckValidWord(invalid_word);
+	}
+	words.erase(remove_if(words.begin(), words.end(), [this](string_view word) {
+		return IsStopWord(word);
+	}), words.end());
+	return words;
+}
+
+int SearchServer::ComputeAverageRating(const vector<int>& ratings) {
+	if (ratings.empty()) {
+		return 0;
+	}
+	int rating_sum = 0;
+	for (const int rating : ratings) {
+		rating_sum += rating;
+	}
+	return rating_sum / static_cast<int>(ratings.size());
+}
+
+void SearchServer::SelectTopDocuments(vector<Document>& documents, size_t max_count) {
+	const auto by_relevance = [](const Document& lhs, const Document& rhs) {
+		if (abs(lhs.relevance - rhs.relevance) < EPSILON) {
+			return lhs.rating > rhs.rating;
+		}
+		else {
+			return lhs.relevance > rhs.relevance;
+		}
+	};
+	if (documents.size() > max_count) {
+		partial_sort(documents.begin(), documents.begin() + max_count, documents.end(), by_relevance);
+		documents.resize(max_count);
+	}
+	else {
+		sort(documents.begin(), documents.end(), by_relevance);
+	}
+}
+
+SearchServer::QueryWord SearchServer::ParseQueryWord(string_view text, const StopWordSet& stop_words) {
+	bool is_minus = false;
+	if (text[0] == '-') {
+		if (text.size() < 2)
+			throw invalid_argument("   -.  \" \"");
+		if (text[1] == '-')
+			throw invalid_argument("     " + string(text));
+		is_minus = true;
+		text.remove_prefix(1);
+	}
+	return { text, is_minus, stop_words.Contains(text) };
+}
+
+string SearchServer::GetNormalizedQuery(string_view raw_query) const {
+	const Query query = ParseQuery(raw_query);
+	string result;
+	for (const string_view word : query.plus_words) {
+		result.append(word).push_back(' ');
+	}
+	for (const string_view word : query.minus_words) {
+		result.append("-"s).append(word).push_back(' ');
+	}
+	if (!result.empty()) {
+		result.pop_back();
+	}
+	return result;
+}
+
+uint64_t SearchServer::GetGeneration() const {
+	return generation_;
+}
+
+uint64_t SearchServer::NextGeneration() {
+	static atomic<uint64_t> last_generation = 0;
+	return ++last_generation;
+}
+
+SearchServer::Query SearchServer::ParseQuery(string_view text, pmr::memory_resource* resource) const {
+	return ParseQuery(text, stop_words_, resource);
+}
+
+SearchServer::Query SearchServer::ParseQuery(string_view text, const StopWordSet& stop_words,
+	pmr::memory_resource* resource) {
+	Query query(resource);
+	pmr::vector<string_view> words(resource);
+	const string_view invalid_word = SplitIntoWords(text, words);
+	if (!invalid_word.empty()) {
+		//  invalid_argument   
+		CheckValidWord(invalid_word);
+	}
+	for (const string_view word : words) {
+		QueryWord query_word = ParseQueryWord(word, stop_words);
+		if (!query_word.is_stop) {
+			if (query_word.is_minus) {
+				query.minus_words.push_back(query_word.data);
+			}
+			else {
+				query.plus_words.push_back(query_word.data);
+			}
+		}
+	}
+	const auto sort_unique = [](pmr::vector<string_view>& words) {
+		sort(words.begin(), words.end());
+		words.erase(unique(words.begin(), words.end()), words.end());
+	};
+	sort_unique(query.plus_words);
+	sort_unique(query.minus_words);
+	return query;
+}
+
+double SearchServer::ComputeWordInverseDocumentFreq(const PostingList& postings) const {
+	return log_document_count_ - postings.log_document_freq;
+}
+
+const SearchServer::PostingList* SearchServer::FindPostingList(string_view word) const {
+	const auto it = word_to_document_freqs_.find(word);
+	if (it == word_to_document_freqs_.end()) {
+		return nullptr;
+	}
+	return &it->second;
+}
+
+const string* SearchServer::FindMatchedWord(string_view word, int ordinal) const {
+	const auto it = word_to_document_freqs_.find(word);
+	if (it == word_to_document_freqs_.end() || !it->second.Contains(ordinal)) {
+		return nullptr;
+	}
+	return &it->first;
+}
+
+namespace {
+	//     from,  values[i] >= target; values[0..size) 
+	size_t GallopLowerBound(const int* values, size_t size, size_t from, int target) {
+		size_t low = from;
+		size_t high = from;
+		size_t step = 1;
+		while (high < size && values[high] < target) {
+			low = high + 1;
+			high = from + step;
+			step *= 2;
+		}
+		high = min(high, size);
+		return lower_bound(values + low, values + high, target) - values;
+	}
+
+	size_t GallopLowerBound(const vector<int>& values, size_t from, int target) {
+		return GallopLowerBound(values.data(), values.size(), from, target);
+	}
+
+	//          ,     
+	const size_t SUBTRACT_LENGTH_RATIO = 8;
+}
+
+SearchServer::PostingList::Cursor::Cursor(const PostingList& postings)
+	: postings_(postings) {
+	if (postings_.IsCompressed()) {
+		LoadBlock(0);
+	}
+}
+
+bool SearchServer::PostingList::Cursor::IsValid() const {
+	if (postings_.IsCompressed()) {
+		return position_ < postings_.BlockCount();
+	}
+	return position_ < postings_.ordinals.size();
+}
+
+int SearchServer::PostingList::Cursor::Ordinal() const {
+	if (postings_.IsCompressed()) {
+		return block_ordinals_[in_block_];
+	}
+	return postings_.ordinals[position_];
+}
+
+void SearchServer::PostingList::Cursor::Next() {
+	if (!postings_.IsCompressed()) {
+		++position_;
+		return;
+	}
+	if (++in_block_ == block_ordinal_count_) {
+		LoadBlock(position_ + 1);
+	}
+}
+
+void SearchServer::PostingList::Cursor::SkipTo(int target) {
+	if (!IsValid()) {
+		return;
+	}
+	if (!postings_.IsCompressed()) {
+		position_ = GallopLowerBound(postings_.ordinals, position_, target);
+		return;
+	}
+	if (block_ordinals_[block_ordinal_count_ - 1] < target) {
+		//  ,     target;   target  
+		const size_t next_block = GallopLowerBound(postings_.block_first_ordinals, position_ + 1, target + 1);
+		LoadBlock(max(next_block - 1, position_ + 1));
+		if (!IsValid()) {
+			return;
+		}
+	}
+	in_block_ = GallopLowerBound(block_ordinals_.data(), block_ordinal_count_, in_block_, target);
+	if (in_block_ == block_ordinal_count_) {
+		LoadBlock(position_ + 1);
+	}
+}
+
+void SearchServer::PostingList::Cursor::LoadBlock(size_t block) {
+	position_ = block;
+	in_block_ = 0;
+	block_ordinal_count_ = 0;
+	if (block >= postings_.BlockCount()) {
+		return;
+	}
+	const uint8_t* data = postings_.encoded.data() + postings_.block_offsets[block];
+	block_ordinal_count_ = min(BLOCK_SIZE, postings_.compressed_size - block * BLOCK_SIZE);
+	int ordinal = postings_.block_first_ordinals[block];
+	for (size_t i = 0; i < block_ordinal_count_; ++i) {
+		if (i > 0) {
+			ordinal += static_cast<int>(DecodeVarint(data));
+		}
+		//  
+		DecodeVarint(data);
+		block_ordinals_[i] = ordinal;
+	}
+}
+
+bool SearchServer::PostingList::Contains(int ordinal) const {
+	Cursor cursor(*this);
+	cursor.SkipTo(ordinal);
+	return cursor.IsValid() && cursor.Ordinal() == ordinal;
+}
+
+void SearchServer::PostingList::Compress() {
+	if (IsCompressed() || ordinals.empty()) {
+		return;
+	}
+	//    ,   -  
+	unordered_map<double, uint32_t> value_counts;
+	for (const double term_freq : term_freqs) {
+		++value_counts[term_freq];
+	}
+	vector<pair<double, uint32_t>> values(value_counts.begin(), value_counts.end());
+	sort(values.begin(), values.end(), [](const pair<double, uint32_t>& lhs, const pair<double, uint32_t>& rhs) {
+		return lhs.second != rhs.second ? lhs.second > rhs.second : lhs.first < rhs.first;
+	});
+	vector<double> new_term_freq_values;
+	new_term_freq_values.reserve(values.size());
+	unordered_map<double, uint32_t> value_indexes;
+	for (const auto& [term_freq, _] : values) {
+		value_indexes.emplace(term_freq, static_cast<uint32_t>(new_term_freq_values.size()));
+		new_term_freq_values.push_back(term_freq);
+	}
+
+	vector<int> new_block_first_ordinals;
+	vector<uint32_t> new_block_offsets;
+	vector<uint8_t> new_encoded;
+	const auto encode_varint = [&new_encoded](uint32_t value) {
+		while (value >= 0x80) {
+			new_encoded.push_back(static_cast<uint8_t>(value | 0x80));
+			value >>= 7;
+		}
+		new_encoded.push_back(static_cast<uint8_t>(value));
+	};
+	for (size_t i = 0; i < ordinals.size(); ++i) {
+		const int ordinal = ordinals[i];
+		if (i % BLOCK_SIZE == 0) {
+			new_block_first_ordinals.push_back(ordinal);
+			new_block_offsets.push_back(static_cast<uint32_t>(new_encoded.size()));
+		}
+		else {
+			encode_varint(static_cast<uint32_t>(ordinal - ordinals[i - 1]));
+		}
+		encode_varint(value_indexes.at(term_freqs[i]));
+	}
+	const size_t compressed_bytes = new_encoded.size() + new_term_freq_values.size() * sizeof(double)
+		+ new_block_offsets.size() * (sizeof(int) + sizeof(uint32_t));
+	if (compressed_bytes >= ordinals.size() * (sizeof(int) + sizeof(double))) {
+		ordinals.shrink_to_fit();
+		term_freqs.shrink_to_fit();
+		return;
+	}
+	new_block_first_ordinals.shrink_to_fit();
+	new_block_offsets.shrink_to_fit();
+	new_encoded.shrink_to_fit();
+	block_first_ordinals = move(new_block_first_ordinals);
+	block_offsets = move(new_block_offsets);
+	encoded = move(new_encoded);
+	term_freq_values = move(new_term_freq_values);
+	compressed_size = ordinals.size();
+	//  {}  ,   ,     swap
+	vector<int>().swap(ordinals);
+	vector<double>().swap(term_freqs);
+}
+
+void SearchServer::PostingList::Decompress() {
+	if (!IsCompressed()) {
+		return;
+	}
+	vector<int> new_ordinals;
+	vector<double> new_term_freqs;
+	new_ordinals.reserve(compressed_size);
+	new_term_freqs.reserve(compressed_size);
+	ForEach([&](int ordinal, double term_freq) {
+		new_ordinals.push_back(ordinal);
+		new_term_freqs.push_back(term_freq);
+	});
+	ordinals = move(new_ordinals);
+	term_freqs = move(new_term_freqs);
+	vector<int>().swap(block_first_ordinals);
+	vector<uint32_t>().swap(block_offsets);
+	vector<uint8_t>().swap(encoded);
+	vector<double>().swap(term_freq_values);
+	compressed_size = 0;
+}
+
+void SearchServer::PostingList::Add(int ordinal, double term_freq) {
+	Decompress();
+	//     ,      push_back
+	const auto it = lower_bound(ordinals.begin(), ordinals.end(), ordinal);
+	const auto position = it - ordinals.begin();
+	ordinals.insert(it, ordinal);
+	term_freqs.insert(term_freqs.begin() + position, term_freq);
+	log_document_freq = log(LiveSize());
+}
+
+vector<Document> SearchServer::FindAllDocuments(const Query& query, DocumentStatus status) const {
+	pmr::map<int, double> ordinal_to_relevance(query.GetResource());
+	for (const string_view word : query.plus_words) {
+		const PostingList* postings = FindPostingList(word);
+		if (postings == nullptr) {
+			continue;
+		}
+		const double inverse_document_freq = ComputeWordInverseDocumentFreq(*postings);
+		postings->ForEach([&](int ordinal, double term_freq) {
+			if (IsLiveOrdinal(ordinal) && statuses_[ordinal] == status) {
+				ordinal_to_relevance[ordinal] += term_freq * inverse_document_freq;
+			}
+		});
+	}
+
+	ExcludeMinusWords(query, ordinal_to_relevance);
+	return MakeDocuments(ordinal_to_relevance);
+}
+
+void SearchServer::SubtractPostings(pmr::map<int, double>& candidates, const PostingList& postings) {
+	if (postings.size() * SUBTRACT_LENGTH_RATIO < candidates.size()) {
+		for (PostingList::Cursor cursor(postings); cursor.IsValid(); cursor.Next()) {
+			candidates.erase(cursor.Ordinal());
+		}
+		return;
+	}
+	PostingList::Cursor cursor(postings);
+	const bool gallop = candidates.size() * SUBTRACT_LENGTH_RATIO < postings.size();
+	for (auto it = candidates.begin(); it != candidates.end() && cursor.IsValid();) {
+		if (gallop) {
+			cursor.SkipTo(it->first);
+		}
+		else {
+			while (cursor.IsValid() && cursor.Ordinal() < it->first) {
+				cursor.Next();
+			}
+		}
+		if (cursor.IsValid() && cursor.Ordinal() == it->first) {
+			it = candidates.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void SearchServer::ExcludeMinusWords(const Query& query, pmr::map<int, double>& ordinal_to_relevance) const {
+	for (const string_view word : query.minus_words) {
+		if (ordinal_to_relevance.empty()) {
+			return;
+		}
+		const PostingList* postings = FindPostingList(word);
+		if (postings != nullptr) {
+			SubtractPostings(ordinal_to_relevance, *postings);
+		}
+	}
+}
+
+vector<Document> SearchServer::MakeDocuments(const pmr::map<int, double>& ordinal_to_relevance) const {
+	vector<Document> matched_documents;
+	matched_documents.reserve(ordinal_to_relevance.size());
+	for (const auto& [ordinal, relevance] : ordinal_to_relevance) {
+		matched_documents.push_back(
+			{ ordinal_to_document_id_[ordinal], relevance, ratings_[ordinal] });
+	}
+	return matched_documents;
+}
+
+void SearchServer::CheckValidWord(string_view word) {
+	if (!none_of(word.begin(), word.end(), [](char c) {
+		return c >= '\0' && c < ' ';
+		}))
+		throw invalid_argument(string(word) + "word is invalid"s);
+}
+
+namespace {
+	static_assert(sizeof(int) == 4, "snapshot stores int as 4 bytes");
+
+	size_t AlignSnapshotOffset(size_t offset) {
+		return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	}
+
+	//      ,     8 .
+	class SnapshotWriter {
+	public:
+		explicit SnapshotWriter(ostream& output)
+			: output_(output) {}
+
+		template <typename T>
+		void WriteArray(const T* values, size_t count) {
+			output_.write(reinterpret_cast<const char*>(values), count * sizeof(T));
+			offset_ += count * sizeof(T);
+			static const char padding[SNAPSHOT_ALIGNMENT] = {};
+			const size_t padding_size = AlignSnapshotOffset(offset_) - offset_;
+			output_.write(padding, padding_size);
+			offset_ += padding_size;
+		}
+
+		template <typename T>
+		void WriteArray(const vector<T>& values) {
+			WriteArray(values.data(), values.size());
+		}
+
+		uint64_t GetOffset() const {
+			return offset_;
+		}
+
+	private:
+		ostream& output_;
+		uint64_t offset_ = 0;
+	};
+}
+
+void SearchServer::Save(ostream& output) const {
+	//  :      ,     .
+	const vector<int> new_ordinals = MakeCompactOrdinals();
+	vector<int> document_ids;
+	vector<int> ratings;
+	vector<int> statuses;
+	document_ids.reserve(document_ordinals_.size());
+	ratings.reserve(document_ordinals_.size());
+	statuses.reserve(document_ordinals_.size());
+	for (size_t ordinal = 0; ordinal < new_ordinals.size(); ++ordinal) {
+		if (new_ordinals[ordinal] >= 0) {
+			document_ids.push_back(ordinal_to_document_id_[ordinal]);
+			ratings.push_back(ratings_[ordinal]);
+			statuses.push_back(static_cast<int>(statuses_[ordinal]));
+		}
+	}
+
+	//   ,  SnapshotIndex    
+	vector<const WordPostings*> words;
+	words.reserve(word_to_document_freqs_.size());
+	for (const WordPostings& word_postings : word_to_document_freqs_) {
+		words.push_back(&word_postings);
+	}
+	sort(words.begin(), words.end(), [](const WordPostings* lhs, const WordPostings* rhs) { return lhs->first < rhs->first; });
+
+	string texts;
+	vector<SnapshotText> stop_word_texts;
+	stop_word_texts.reserve(stop_words_.size());
+	for (const string& stop_word : stop_words_) {
+		stop_word_texts.push_back({ texts.size(), stop_word.size() });
+		texts += stop_word;
+	}
+	vector<SnapshotWord> word_records;
+	word_records.reserve(words.size());
+	for (const WordPostings* word_postings : words) {
+		word_records.push_back({ { texts.size(), word_postings->first.size() }, 0, word_postings->second.LiveSize() });
+		texts += word_postings->first;
+	}
+
+	const SnapshotHeader header = { SNAPSHOT_MAGIC, SNAPSHOT_VERSION, stop_word_texts.size(), document_ids.size(),
+		word_records.size(), texts.size() };
+	//      ,  - ,  
+	uint64_t postings_offset = sizeof(SnapshotHeader) + AlignSnapshotOffset(stop_word_texts.size() * sizeof(SnapshotText))
+		+ 3 * AlignSnapshotOffset(document_ids.size() * sizeof(int)) + word_records.size() * sizeof(SnapshotWord)
+		+ AlignSnapshotOffset(texts.size());
+	for (SnapshotWord& record : word_records) {
+		record.postings_offset = postings_offset;
+		postings_offset += AlignSnapshotOffset(record.posting_count * sizeof(int)) + record.posting_count * sizeof(double);
+	}
+
+	SnapshotWriter writer(output);
+	writer.WriteArray(&header, 1);
+	writer.WriteArray(stop_word_texts);
+	writer.WriteArray(document_ids);
+	writer.WriteArray(ratings);
+	writer.WriteArray(statuses);
+	writer.WriteArray(word_records);
+	writer.WriteArray(texts.data(), texts.size());
+	vector<int> ordinals;
+	vector<double> term_freqs;
+	for (const WordPostings* word_postings : words) {
+		//       
+		ordinals.clear();
+		term_freqs.clear();
+		word_postings->second.ForEach([&](int ordinal, double term_freq) {
+			if (new_ordinals[ordinal] >= 0) {
+				ordinals.push_back(new_ordinals[ordinal]);
+				term_freqs.push_back(term_freq);
+			}
+		});
+		writer.WriteArray(ordinals);
+		writer.WriteArray(term_freqs);
+	}
+}
+
+SearchServer SearchServer::Load(istream& input) {
+	string data;
+	char buffer[1 << 16];
+	while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0) {
+		data.append(buffer, input.gcount());
+	}
+	const SnapshotIndex snapshot(data);
+
+	SearchServer server(snapshot.stop_words_);
+	const size_t document_count = snapshot.document_ids_.size();
+	server.ordinal_to_document_id_.assign(snapshot.document_ids_.begin(), snapshot.document_ids_.end());
+	server.ratings_.assign(snapshot.ratings_.begin(), snapshot.ratings_.end());
+	server.statuses_.reserve(document_count);
+	for (const int status : snapshot.statuses_) {
+		server.statuses_.push_back(static_cast<DocumentStatus>(status));
+	}
+	for (size_t ordinal = 0; ordinal < document_count; ++ordinal) {
+		if (!server.document_ordinals_.emplace(server.ordinal_to_document_id_[ordinal], static_cast<int>(ordinal)).second) {
+			throw invalid_argument(" ");
+		}
+		server.live_ordinals_.PushBack();
+	}
+
+	vector<WordPostings*> words;
+	words.reserve(snapshot.words_.size());
+	for (const SnapshotWord& record : snapshot.words_) {
+		PostingList postings;
+		const span<const int> ordinals = snapshot.GetOrdinals(record);
+		const span<const double> term_freqs = snapshot.GetTermFreqs(record);
+		postings.ordinals.assign(ordinals.begin(), ordinals.end());
+		postings.term_freqs.assign(term_freqs.begin(), term_freqs.end());
+		postings.log_document_freq = log(postings.size());
+		words.push_back(&*server.word_to_document_freqs_.emplace(string(snapshot.GetText(record.text)), move(postings)).first);
+	}
+
+	//  :     ,   ,
+	//  ,     
+	vector<size_t>& word_offsets = server.document_word_offsets_;
+	word_offsets.assign(document_count + 1, 0);
+	for (const WordPostings* word : words) {
+		for (const int ordinal : word->second.ordinals) {
+			++word_offsets[ordinal + 1];
+		}
+	}
+	partial_sum(word_offsets.begin(), word_offsets.end(), word_offsets.begin());
+	server.document_words_.resize(word_offsets.back());
+	vector<size_t> word_positions(word_offsets.begin(), word_offsets.end() - 1);
+	for (WordPostings* word : words) {
+		const PostingList& stored = word->second;
+		for (size_t j = 0; j < stored.size(); ++j) {
+			server.document_words_[word_positions[stored.ordinals[j]]++] = { word, stored.term_freqs[j] };
+		}
+	}
+	server.log_document_count_ = log(server.GetDocumentCount());
+	return server;
+}
@@ -1,15 +1,36 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <memory_resource>
+#include <numeric>
 #include <set>
 #include <stdexcept>
 #include <algorithm>
-
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <execution>
+#include <functional>
+#include <iostream>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+#include "concurrent_map.h"
 #include "document.h"
+#include "query_arena.h"
+#include "stop_word_set.h"
 #include "string_processing.h"
 
+const int MAX_RESULT_DOCUMENT_COUNT = 5;
+const double EPSILON = 1e-6;
+
+class SnapshotIndex;
+
 class SearchServer {
 public:
 
@@ -17,246 +38,613 @@ public:
 	explicit SearchServer(const StringContainer& stop_words)
 		: stop_words_(MakeUniqueNonEmptyStrings(stop_words)) {}
 
-	explicit SearchServer(const string& stop_words_text)
-		: SearchServer(
-			SplitIntoWords(stop_words_text)) {}
-
-	void AddDocument(int document_id, const string& document, DocumentStatus status,
-		const vector<int>& ratings) {
-		if (document_id < 0)
-			throw invalid_argument("ID     0.");
-		if (documents_.count(document_id) != 0)
-			throw invalid_argument("   ID  .");
-		const vector<string> words = SplitIntoWordsNoStop(document);
-		const double inv_word_count = 1.0 / words.size();
-		for (const string& word : words) {
-			CheckValidWord(word);
-			word_to_document_freqs_[word][document_id] += inv_word_count;
+	explicit SearchServer(const std::string& stop_words_text);
+
+	explicit SearchServer(std::string_view stop_words_text);
+
+	//        ,     .
+	//     (GetGeneration).
+	SearchServer(const SearchServer& other);
+
+	SearchServer& operator=(const SearchServer& other);
+
+	//      ,      
+	SearchServer(SearchServer&& other) = default;
+
+	SearchServer& operator=(SearchServer&& other) = default;
+
+	void AddDocument(int document_id, std::string_view document, DocumentStatus status,
+		const std::vector<int>& ratings);
+
+	//  .     ,   
+	// (, )        .
+	//   ,   AddDocument,     :   
+	//    ,    AddDocument,      .
+	void AddDocuments(const std::vector<DocumentInput>& documents);
+
+	template <typename ExecutionPolicy>
+	void AddDocuments(ExecutionPolicy&& policy, const std::vector<DocumentInput>& documents) {
+		if (documents.empty()) {
+			return;
 		}
-		documents_.emplace(document_id, DocumentData{ ComputeAverageRating(ratings), status });
-		doc_id_.push_back(document_id);
+		std::vector<TokenizedDocument> tokenized(documents.size());
+		std::transform(policy, documents.begin(), documents.end(), tokenized.begin(),
+			[this](const DocumentInput& document) {
+				return TokenizeDocument(document.text);
+			});
+		std::vector<BatchPosting> postings = PrepareBatch(documents, tokenized);
+		std::sort(policy, postings.begin(), postings.end());
+		MergeBatch(documents, postings);
 	}
 
 
 	//new  2  6
-	vector<Document> FindTopDocuments(const string& raw_query) const
+	// max_count -    
+	std::vector<Document> FindTopDocuments(std::string_view raw_query) const;
+
+	std::vector<Document> FindTopDocuments(std::string_view raw_query,
+		DocumentStatus status, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) const;
+
+	template<typename DocumentPredicate >
+	std::vector<Document> FindTopDocuments(std::string_view raw_query,
+		DocumentPredicate doc_predicate, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) const
 	{
-		return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
+		return FindTopDocuments(std::execution::seq, raw_query, doc_predicate, max_count);
 	}
 
-	vector<Document> FindTopDocuments(const string& raw_query,
-		DocumentStatus status) const {
-		return FindTopDocuments(raw_query, [status](int document_id, DocumentStatus status_, int rating) { return status_ == status; });
+	//    .  std::execution::par 
+	//   ConcurrentMap,     .
+	//       .
+	template <typename ExecutionPolicy>
+	std::vector<Document> FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query) const {
+		return FindTopDocuments(policy, raw_query, DocumentStatus::ACTUAL);
 	}
 
-	template<typename DocumentPredicate >
-	vector<Document> FindTopDocuments(const string& raw_query,
-		DocumentPredicate doc_predicate) const
+	template <typename ExecutionPolicy>
+	std::vector<Document> FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query,
+		DocumentStatus status, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) const {
+		return FindTopDocuments(policy, raw_query, [status](int document_id, DocumentStatus status_, int rating) { return status_ == status; }, max_count);
+	}
+
+	template <typename ExecutionPolicy, typename DocumentPredicate>
+	std::vector<Document> FindTopDocuments(ExecutionPolicy&& policy, std::string_view raw_query,
+		DocumentPredicate doc_predicate, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) const
 	{
-		const Query query = ParseQuery(raw_query);
-		vector<Document> result = FindAllDocuments(query, doc_predicate);
+		QueryArena arena;
+		const Query query = ParseQuery(raw_query, arena.GetResource());
+		std::vector<Document> result = FindAllDocuments(policy, query, doc_predicate);
+		SelectTopDocuments(result, max_count);
+		return result;
+	}
 
-		sort(result.begin(), result.end(),
-			[](const Document& lhs, const Document& rhs) {
-				if (abs(lhs.relevance - rhs.relevance) < EPSILON) {
-					return lhs.rating > rhs.rating;
-				}
-				else {
-					return lhs.relevance > rhs.relevance;
-				}
+	//   ,      .
+	// ,       (. SearchCursor).
+	template <typename DocumentPredicate>
+	std::vector<Document> FindMatchingDocuments(std::string_view raw_query, DocumentPredicate doc_predicate) const {
+		QueryArena arena;
+		return FindAllDocuments(ParseQuery(raw_query, arena.GetResource()), doc_predicate);
+	}
+
+	int GetDocumentCount() const;
+
+	std::tuple<std::vector<std::string>, DocumentStatus> MatchDocument(std::string_view raw_query,
+		int document_id) const;
+
+	//    ,     . string_view   
+	//   ,        . -
+	//  :      , -  .
+	//  std::execution::par    .
+	template <typename ExecutionPolicy>
+	std::tuple<std::vector<std::string_view>, DocumentStatus> MatchDocument(ExecutionPolicy&& policy,
+		std::string_view raw_query, int document_id) const {
+		QueryArena arena;
+		const Query query = ParseQuery(raw_query, arena.GetResource());
+		const int ordinal = document_ordinals_.at(document_id);
+		const bool has_minus_word = std::any_of(policy, query.minus_words.begin(), query.minus_words.end(),
+			[this, ordinal](std::string_view word) {
+				return FindMatchedWord(word, ordinal) != nullptr;
 			});
-		if (result.size() > MAX_RESULT_DOCUMENT_COUNT) {
-			result.resize(MAX_RESULT_DOCUMENT_COUNT);
+		if (has_minus_word) {
+			return { std::vector<std::string_view>(), statuses_[ordinal] };
 		}
-		return result;
+		std::pmr::vector<const std::string*> matched(query.plus_words.size(), arena.GetResource());
+		std::transform(policy, query.plus_words.begin(), query.plus_words.end(), matched.begin(),
+			[this, ordinal](std::string_view word) {
+				return FindMatchedWord(word, ordinal);
+			});
+		// plus_words     ,   
+		std::vector<std::string_view> matched_words;
+		matched_words.reserve(matched.size());
+		for (const std::string* word : matched) {
+			if (word != nullptr) {
+				matched_words.emplace_back(*word);
+			}
+		}
+		return { std::move(matched_words), statuses_[ordinal] };
 	}
 
-	int GetDocumentCount() const {
-		return documents_.size();
+	// id     index  ,   ; O(log N).
+	//  out_of_range,  index  [0, GetDocumentCount()).
+	int GetDocumentId(int index) const;
+
+	//    : -  ,  -  '-',
+	//  -  .         .
+	std::string GetNormalizedQuery(std::string_view raw_query) const;
+
+	//       .  
+	//          .
+	uint64_t GetGeneration() const;
+
+	//     .   id -  .
+	//        : O(w)  w  .
+	std::map<std::string_view, double> GetWordFrequencies(int document_id) const;
+
+	//  : -, , ,    id   
+	//   (   snapshot_index.h).   -   ,
+	//      ,     (MappedFile)  
+	//    SnapshotIndex.      ,  .
+	void Save(std::ostream& output) const;
+
+	//     :    ,  SnapshotIndex,  
+	//   ,     .
+	//  invalid_argument,      .
+	static SearchServer Load(std::istream& input);
+
+	//     :     varint,
+	//  -      .     
+	//  ,    .    .
+	// ,   AddDocument,   .
+	void CompressPostingLists();
+
+	//        ,     :
+	//    ,        .
+	//    O(  )       O(1)
+	//    ,  O(log N)  ,      .
+	//  id .
+	void RemoveDocument(int document_id);
+
+	//         ,
+	//         .
+	template <typename ExecutionPolicy>
+	void RemoveDocument(ExecutionPolicy&& policy, int document_id) {
+		const auto ordinal_it = document_ordinals_.find(document_id);
+		if (ordinal_it == document_ordinals_.end()) {
+			return;
+		}
+		const int ordinal = ordinal_it->second;
+		EraseDocumentRecord(document_id);
+		std::for_each(policy, DocumentWordsBegin(ordinal), DocumentWordsEnd(ordinal),
+			[this](const DocumentWord& document_word) {
+				document_word.word->second.MarkRemoved([this](int removed) { return !IsLiveOrdinal(removed); });
+			});
+		EraseEmptyWords(DocumentWordsBegin(ordinal), DocumentWordsEnd(ordinal));
+		FinishRemoval();
 	}
 
-	tuple<vector<string>, DocumentStatus> MatchDocument(const string& raw_query,
-		int document_id) const {
-		const Query query = ParseQuery(raw_query);
-		vector<string> matched_words;
-		for (const string& word : query.plus_words) {
-			if (word_to_document_freqs_.count(word) == 0) {
-				continue;
+	//      ,  RemoveDocument,   
+	//         .  id .
+	void RemoveDocuments(const std::vector<int>& document_ids);
+
+
+
+private:
+	// SnapshotIndex        ,  
+	friend class SnapshotIndex;
+
+	//   ConcurrentMap    
+	static const size_t RELEVANCE_BUCKET_COUNT = 128;
+	// id  ordinal_to_document_id_    
+	static const int REMOVED_DOCUMENT_ID = -1;
+
+	// ,    :       
+	//   ,       .
+	//         (RemoveIf),   - removed_count.
+	// log_document_freq = log(LiveSize())    ,   
+	// IDF = log(N) - log(LiveSize())      .
+	//
+	//  Compress  ,     encoded   BLOCK_SIZE:
+	//    varint   (   )  varint 
+	//   term_freq_values.      ( 
+	//       ),     
+	//   ,      O(1)   
+	//   .        ,
+	//    .
+	struct PostingList {
+		static constexpr size_t BLOCK_SIZE = 128;
+
+		std::vector<int> ordinals;
+		std::vector<double> term_freqs;
+		std::vector<int> block_first_ordinals;
+		std::vector<uint32_t> block_offsets;
+		std::vector<uint8_t> encoded;
+		std::vector<double> term_freq_values;
+		size_t compressed_size = 0;
+		size_t removed_count = 0;
+		double log_document_freq = 0.0;
+
+		//       
+		size_t size() const {
+			return IsCompressed() ? compressed_size : ordinals.size();
+		}
+
+		//  ,    
+		size_t LiveSize() const {
+			return size() - removed_count;
+		}
+
+		bool IsCompressed() const {
+			return !block_offsets.empty();
+		}
+
+		size_t BlockCount() const {
+			return IsCompressed() ? block_offsets.size() : (ordinals.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+		}
+
+		// action(ordinal, term_freq)       
+		template <typename Action>
+		void ForEachInBlock(size_t block, Action action) const {
+			if (!IsCompressed()) {
+				const size_t end = std::min(ordinals.size(), (block + 1) * BLOCK_SIZE);
+				for (size_t i = block * BLOCK_SIZE; i < end; ++i) {
+					action(ordinals[i], term_freqs[i]);
+				}
+				return;
 			}
-			if (word_to_document_freqs_.at(word).count(document_id)) {
-				matched_words.push_back(word);
+			const uint8_t* data = encoded.data() + block_offsets[block];
+			const size_t count = std::min(BLOCK_SIZE, compressed_size - block * BLOCK_SIZE);
+			int ordinal = block_first_ordinals[block];
+			for (size_t i = 0; i < count; ++i) {
+				if (i > 0) {
+					ordinal += static_cast<int>(DecodeVarint(data));
+				}
+				action(ordinal, term_freq_values[DecodeVarint(data)]);
 			}
 		}
-		for (const string& word : query.minus_words) {
-			if (word_to_document_freqs_.count(word) == 0) {
-				continue;
+
+		template <typename Action>
+		void ForEach(Action action) const {
+			for (size_t block = 0; block < BlockCount(); ++block) {
+				ForEachInBlock(block, action);
+			}
+		}
+
+		//      . SkipTo  :  ,
+		//    ,      , 
+		//  k   O(log k).       
+		//  block_first_ordinals,      .
+		class Cursor {
+		public:
+			explicit Cursor(const PostingList& postings);
+
+			bool IsValid() const;
+
+			int Ordinal() const;
+
+			void Next();
+
+			//         target
+			void SkipTo(int target);
+
+		private:
+			const PostingList& postings_;
+			//    -   ordinals,   -  
+			size_t position_ = 0;
+			//   ,      
+			std::array<int, BLOCK_SIZE> block_ordinals_;
+			size_t block_ordinal_count_ = 0;
+			size_t in_block_ = 0;
+
+			void LoadBlock(size_t block);
+		};
+
+		bool Contains(int ordinal) const;
+
+		void Add(int ordinal, double term_freq);
+
+		// ,      .     ,
+		//     ,         O(1).
+		template <typename IsRemoved>
+		void MarkRemoved(IsRemoved is_removed) {
+			++removed_count;
+			if (removed_count * 2 > size()) {
+				RemoveIf(is_removed);
 			}
-			if (word_to_document_freqs_.at(word).count(document_id)) {
-				matched_words.clear();
-				break;
+			else {
+				log_document_freq = std::log(LiveSize());
 			}
 		}
-		return make_tuple(matched_words, documents_.at(document_id).status);
-	}
 
-	int GetDocumentId(int index) const {
-		return doc_id_.at(index);
-	}
+		//     ,    is_removed(ordinal) ;
+		//    
+		template <typename IsRemoved>
+		void RemoveIf(IsRemoved is_removed) {
+			const bool was_compressed = IsCompressed();
+			Decompress();
+			size_t kept = 0;
+			for (size_t i = 0; i < ordinals.size(); ++i) {
+				if (!is_removed(ordinals[i])) {
+					ordinals[kept] = ordinals[i];
+					term_freqs[kept] = term_freqs[i];
+					++kept;
+				}
+			}
+			ordinals.resize(kept);
+			term_freqs.resize(kept);
+			removed_count = 0;
+			log_document_freq = std::log(size());
+			if (was_compressed) {
+				Compress();
+			}
+		}
 
+		//  ,       (   ).
+		void Compress();
 
+		void Decompress();
 
-private:
-	struct DocumentData {
-		int rating;
-		DocumentStatus status;
+		static uint32_t DecodeVarint(const uint8_t*& data) {
+			uint32_t value = 0;
+			int shift = 0;
+			while (*data & 0x80) {
+				value |= static_cast<uint32_t>(*data++ & 0x7F) << shift;
+				shift += 7;
+			}
+			return value | static_cast<uint32_t>(*data++) << shift;
+		}
 	};
 
-	set<string> stop_words_;
-	map<string, map<int, double>> word_to_document_freqs_;
-	map<int, DocumentData> documents_;
-	vector<int> doc_id_;
+	//     : 1   , 0  .
+	//  i-  ,      .
+	class LiveOrdinals {
+	public:
+		//    size()
+		void PushBack();
 
-	bool IsStopWord(const string& word) const {
-		return stop_words_.count(word) > 0;
-	}
+		void Erase(int ordinal);
+
+		//  index-  ; index   
+		int Select(int index) const;
+
+		size_t size() const {
+			return tree_.size();
+		}
+
+	private:
+		// tree_[i - 1] -     (i - lowbit(i), i]
+		std::vector<int> tree_;
+	};
+
+	//      string_view   
+	struct StringHash {
+		using is_transparent = void;
+
+		size_t operator()(std::string_view text) const {
+			return std::hash<std::string_view>{}(text);
+		}
+	};
+
+	StopWordSet stop_words_;
+	std::unordered_map<std::string, PostingList, StringHash, std::equal_to<>> word_to_document_freqs_;
+	//       (ordinal),   .
+	//   ,   id,        ,
+	//         .    
+	//  ,   id  REMOVED_DOCUMENT_ID.   
+	//  ,  ,   (CompactOrdinals).
+	std::unordered_map<int, int> document_ordinals_;
+	std::vector<int> ordinal_to_document_id_;
+	std::vector<int> ratings_;
+	std::vector<DocumentStatus> statuses_;
+	// log(GetDocumentCount()),     
+	double log_document_count_ = 0.0;
+	uint64_t generation_ = NextGeneration();
+	LiveOrdinals live_ordinals_;
+
+	using WordPostings = std::pair<const std::string, PostingList>;
+
+	//  :  word_to_document_freqs_ (     )
+	//     .
+	struct DocumentWord {
+		WordPostings* word;
+		double term_freq;
+	};
 
-	vector<string> SplitIntoWordsNoStop(const string& text) const {
-		vector<string> words;
-		for (const string& word : SplitIntoWords(text)) {
-			CheckValidWord(word);
-			if (!IsStopWord(word)) {
-				words.push_back(word);
+	//    :     ordinal   
+	//  document_words_  [document_word_offsets_[ordinal], document_word_offsets_[ordinal + 1]),
+	//       .     
+	//     .
+	std::vector<DocumentWord> document_words_;
+	std::vector<size_t> document_word_offsets_ = { 0 };
+
+	static uint64_t NextGeneration();
+
+	template <typename StringContainer>
+	static std::set<std::string, std::less<>> MakeUniqueNonEmptyStrings(const StringContainer& strings) {
+		std::set<std::string, std::less<>> non_empty_strings;
+		for (const auto& str : strings) {
+			CheckValidWord(str);
+			if (!std::string_view(str).empty()) {
+				non_empty_strings.emplace(str);
 			}
 		}
-		return words;
+		return non_empty_strings;
 	}
 
-	static int ComputeAverageRating(const vector<int>& ratings) {
-		if (ratings.empty()) {
-			return 0;
-		}
-		int rating_sum = 0;
-		for (const int rating : ratings) {
-			rating_sum += rating;
+	//    .      ,   - .
+	struct TokenizedDocument {
+		std::map<std::string_view, double> word_freqs;
+		std::exception_ptr error;
+	};
+
+	//  (, ) ;     DocumentInput
+	struct BatchPosting {
+		std::string_view word;
+		int ordinal;
+		double term_freq;
+
+		bool operator<(const BatchPosting& other) const {
+			return std::tie(word, ordinal) < std::tie(other.word, other.ordinal);
 		}
-		return rating_sum / static_cast<int>(ratings.size());
+	};
+
+	//     -;  invalid_argument   
+	TokenizedDocument ComputeWordFreqs(std::string_view text) const;
+
+	TokenizedDocument TokenizeDocument(std::string_view text) const;
+
+	//      .     .
+	std::vector<BatchPosting> PrepareBatch(const std::vector<DocumentInput>& documents,
+		const std::vector<TokenizedDocument>& tokenized) const;
+
+	// postings     ,    
+	void MergeBatch(const std::vector<DocumentInput>& documents, const std::vector<BatchPosting>& postings);
+
+	bool IsStopWord(std::string_view word) const;
+
+	const DocumentWord* DocumentWordsBegin(int ordinal) const {
+		return document_words_.data() + document_word_offsets_[ordinal];
+	}
+
+	const DocumentWord* DocumentWordsEnd(int ordinal) const {
+		return document_words_.data() + document_word_offsets_[ordinal + 1];
+	}
+
+	//     ,     .   .
+	void EraseEmptyWords(const DocumentWord* begin, const DocumentWord* end);
+
+	//   .       .
+	void EraseDocumentRecord(int document_id);
+
+	//         :
+	//  log(N)       .
+	void FinishRemoval();
+
+	bool IsLiveOrdinal(int ordinal) const {
+		return ordinal_to_document_id_[ordinal] != REMOVED_DOCUMENT_ID;
 	}
 
+	//     :      ,   -1.
+	std::vector<int> MakeCompactOrdinals() const;
+
+	//        .
+	//  O(N +   ),  ,    ,  ,
+	//       N / 2 ,      O( ).
+	void CompactOrdinals();
+
+	std::pmr::vector<std::string_view> SplitIntoWordsNoStop(std::string_view text) const;
+
+	static int ComputeAverageRating(const std::vector<int>& ratings);
+
+	//  max_count      (  - ).
+	//   ,    : O(n log max_count).
+	static void SelectTopDocuments(std::vector<Document>& documents, size_t max_count);
+
 	struct QueryWord {
-		string data;
+		std::string_view data;
 		bool is_minus;
 		bool is_stop;
 	};
 
-	QueryWord ParseQueryWord(string text) const {
-		bool is_minus = false;
-		if (text[0] == '-') {
-			if (text.size() < 2)
-				throw invalid_argument("   -.  \" \"");
-			if (text[1] == '-')
-				throw invalid_argument("     " + text);
-			is_minus = true;
-			text = text.substr(1);
-		}
-		return { text, is_minus, IsStopWord(text) };
-	}
+	static QueryWord ParseQueryWord(std::string_view text, const StopWordSet& stop_words);
 
+	//     .    ,
+	//  Query     .   
+	//  resource;    FindAllDocuments    .
 	struct Query {
-		set<string> plus_words;
-		set<string> minus_words;
-	};
+		explicit Query(std::pmr::memory_resource* resource)
+			: plus_words(resource), minus_words(resource) {}
 
-	Query ParseQuery(const string& text) const {
-		Query query;
-		for (const string& word : SplitIntoWords(text)) {
-			CheckValidWord(word);
-			QueryWord query_word = ParseQueryWord(word);
-			if (!query_word.is_stop) {
-				if (query_word.is_minus) {
-					query.minus_words.insert(query_word.data);
-				}
-				else {
-					query.plus_words.insert(query_word.data);
-				}
-			}
+		std::pmr::vector<std::string_view> plus_words;
+		std::pmr::vector<std::string_view> minus_words;
+
+		std::pmr::memory_resource* GetResource() const {
+			return plus_words.get_allocator().resource();
 		}
-		return query;
-	}
+	};
 
+	Query ParseQuery(std::string_view text,
+		std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
 
-	double ComputeWordInverseDocumentFreq(const string& word) const {
-		return log(GetDocumentCount() * 1.0 / word_to_document_freqs_.at(word).size());
-	}
+	static Query ParseQuery(std::string_view text, const StopWordSet& stop_words, std::pmr::memory_resource* resource);
+
+
+	double ComputeWordInverseDocumentFreq(const PostingList& postings) const;
+
+	// nullptr,        
+	const PostingList* FindPostingList(std::string_view word) const;
+
+	//   ,     ,  nullptr
+	const std::string* FindMatchedWord(std::string_view word, int ordinal) const;
+
+	//   candidates   postings.     ,
+	//     :   - 
+	//   candidates,       ,
+	//      .
+	static void SubtractPostings(std::pmr::map<int, double>& candidates, const PostingList& postings);
+
+	void ExcludeMinusWords(const Query& query, std::pmr::map<int, double>& ordinal_to_relevance) const;
 
 	// 2  6
 	template <typename DocumentPredicate>
-	vector<Document> FindAllDocuments(const Query& query, DocumentPredicate doc_predicate) const {
-		map<int, double> document_to_relevance;
-		for (const string& word : query.plus_words) {
-			if (word_to_document_freqs_.count(word) == 0) {
+	std::vector<Document> FindAllDocuments(const Query& query, DocumentPredicate doc_predicate) const {
+		std::pmr::map<int, double> ordinal_to_relevance(query.GetResource());
+		for (const std::string_view word : query.plus_words) {
+			const PostingList* postings = FindPostingList(word);
+			if (postings == nullptr) {
 				continue;
 			}
-			const double inverse_document_freq = ComputeWordInverseDocumentFreq(word);
-			for (const auto [document_id, term_freq] : word_to_document_freqs_.at(word)) {
-				if (doc_predicate(document_id, documents_.at(document_id).status, documents_.at(document_id).rating)) {
-					document_to_relevance[document_id] += term_freq * inverse_document_freq;
+			const double inverse_document_freq = ComputeWordInverseDocumentFreq(*postings);
+			postings->ForEach([&](int ordinal, double term_freq) {
+				if (IsLiveOrdinal(ordinal)
+					&& doc_predicate(ordinal_to_document_id_[ordinal], statuses_[ordinal], ratings_[ordinal])) {
+					ordinal_to_relevance[ordinal] += term_freq * inverse_document_freq;
 				}
-			}
-		}
-
-		for (const string& word : query.minus_words) {
-			if (word_to_document_freqs_.count(word) == 0) {
-				continue;
-			}
-			for (const auto [document_id, _] : word_to_document_freqs_.at(word)) {
-				document_to_relevance.erase(document_id);
-			}
+			});
 		}
 
-		vector<Document> matched_documents;
-		for (const auto [document_id, relevance] : document_to_relevance) {
-			matched_documents.push_back(
-				{ document_id, relevance, documents_.at(document_id).rating });
-		}
-		return matched_documents;
+		ExcludeMinusWords(query, ordinal_to_relevance);
+		return MakeDocuments(ordinal_to_relevance);
 	}
 
-	vector<Document> FindAllDocuments(const Query& query, DocumentStatus status) const {
-		map<int, double> document_to_relevance;
-		for (const string& word : query.plus_words) {
-			if (word_to_document_freqs_.count(word) == 0) {
-				continue;
-			}
-			const double inverse_document_freq = ComputeWordInverseDocumentFreq(word);
-			for (const auto [document_id, term_freq] : word_to_document_freqs_.at(word)) {
-				if (documents_.at(document_id).status == status) {
-					document_to_relevance[document_id] += term_freq * inverse_document_freq;
-				}
-			}
+	//     ,      .
+	//        ,    
+	//     ,     .
+	template <typename ExecutionPolicy, typename DocumentPredicate>
+	std::vector<Document> FindAllDocuments(ExecutionPolicy&& policy, const Query& query, DocumentPredicate doc_predicate) const {
+		if constexpr (std::is_same_v<std::decay_t<ExecutionPolicy>, std::execution::sequenced_policy>) {
+			return FindAllDocuments(query, doc_predicate);
 		}
-
-		for (const string& word : query.minus_words) {
-			if (word_to_document_freqs_.count(word) == 0) {
-				continue;
-			}
-			for (const auto [document_id, _] : word_to_document_freqs_.at(word)) {
-				document_to_relevance.erase(document_id);
+		else {
+			ConcurrentMap<int, double> ordinal_to_relevance(RELEVANCE_BUCKET_COUNT);
+			for (const std::string_view word : query.plus_words) {
+				const PostingList* postings = FindPostingList(word);
+				if (postings == nullptr) {
+					continue;
+				}
+				const double inverse_document_freq = ComputeWordInverseDocumentFreq(*postings);
+				std::vector<size_t> blocks(postings->BlockCount());
+				std::iota(blocks.begin(), blocks.end(), 0);
+				std::for_each(policy, blocks.begin(), blocks.end(), [&](size_t block) {
+					postings->ForEachInBlock(block, [&](int ordinal, double term_freq) {
+						if (IsLiveOrdinal(ordinal)
+							&& doc_predicate(ordinal_to_document_id_[ordinal], statuses_[ordinal], ratings_[ordinal])) {
+							ordinal_to_relevance[ordinal].ref_to_value += term_freq * inverse_document_freq;
+						}
+					});
+				});
 			}
-		}
 
-		vector<Document> matched_documents;
-		for (const auto [document_id, relevance] : document_to_relevance) {
-			matched_documents.push_back(
-				{ document_id, relevance, documents_.at(document_id).rating });
+			// -      
+			std::pmr::map<int, double> result(query.GetResource());
+			ordinal_to_relevance.MergeInto(result);
+			ExcludeMinusWords(query, result);
+			return MakeDocuments(result);
 		}
-		return matched_documents;
 	}
 
-	static void CheckValidWord(const string& word) {
-		if (!none_of(word.begin(), word.end(), [](char c) {
-			return c >= '\0' && c < ' ';
-			}))
-			throw invalid_argument(word + "word is invalid"s);
-	}
-};
+	std::vector<Document> FindAllDocuments(const Query& query, DocumentStatus status) const;
 
+	//       id
+	std::vector<Document> MakeDocuments(const std::pmr::map<int, double>& ordinal_to_relevance) const;
+
+	static void CheckValidWord(std::string_view word);
+};
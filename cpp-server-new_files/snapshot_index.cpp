@@ -0,0 +1,268 @@
+#include "snapshot_index.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string& path) {
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw runtime_error("    " + path);
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		throw runtime_error("     " + path);
+	}
+	size_ = static_cast<size_t>(size.QuadPart);
+	//    ,    
+	if (size_ > 0) {
+		const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping != nullptr) {
+			data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			//     
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+	if (size_ > 0 && data_ == nullptr) {
+		throw runtime_error("      " + path);
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data_ != nullptr) {
+		UnmapViewOfFile(data_);
+	}
+}
+
+#else
+
+MappedFile::MappedFile(const string& path) {
+	const int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw runtime_error("    " + path);
+	}
+	struct stat file_stat;
+	if (fstat(file, &file_stat) != 0) {
+		close(file);
+		throw runtime_error("     " + path);
+	}
+	size_ = static_cast<size_t>(file_stat.st_size);
+	//    ,    
+	if (size_ > 0) {
+		void* memory = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0);
+		if (memory != MAP_FAILED) {
+			data_ = static_cast<const char*>(memory);
+		}
+	}
+	//     
+	close(file);
+	if (size_ > 0 && data_ == nullptr) {
+		throw runtime_error("      " + path);
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data_ != nullptr) {
+		munmap(const_cast<char*>(data_), size_);
+	}
+}
+
+#endif
+
+string_view MappedFile::GetData() const {
+	return { data_, size_ };
+}
+
+namespace {
+	size_t AlignUp(size_t offset) {
+		return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+	}
+
+	//     , ,      .
+	class SnapshotParser {
+	public:
+		explicit SnapshotParser(string_view data)
+			: data_(data) {}
+
+		template <typename T>
+		span<const T> TakeArray(uint64_t count) {
+			if (count > (data_.size() - offset_) / sizeof(T)) {
+				throw invalid_argument(" ");
+			}
+			const T* values = reinterpret_cast<const T*>(data_.data() + offset_);
+			offset_ += count * sizeof(T);
+			//       
+			offset_ = min(AlignUp(offset_), data_.size());
+			return { values, count };
+		}
+
+		size_t GetOffset() const {
+			return offset_;
+		}
+
+	private:
+		string_view data_;
+		size_t offset_ = 0;
+	};
+
+	void CheckSnapshot(bool condition) {
+		if (!condition) {
+			throw invalid_argument(" ");
+		}
+	}
+}
+
+SnapshotIndex::SnapshotIndex(string_view data)
+	: data_(data.data()) {
+	if (reinterpret_cast<uintptr_t>(data.data()) % SNAPSHOT_ALIGNMENT != 0) {
+		throw invalid_argument("     8 ");
+	}
+	SnapshotParser parser(data);
+	const span<const SnapshotHeader> header = parser.TakeArray<SnapshotHeader>(1);
+	if (header[0].magic != SNAPSHOT_MAGIC || header[0].version != SNAPSHOT_VERSION) {
+		throw invalid_argument("  ");
+	}
+	const span<const SnapshotText> stop_words = parser.TakeArray<SnapshotText>(header[0].stop_word_count);
+	document_ids_ = parser.TakeArray<int>(header[0].document_count);
+	ratings_ = parser.TakeArray<int>(header[0].document_count);
+	statuses_ = parser.TakeArray<int>(header[0].document_count);
+	words_ = parser.TakeArray<SnapshotWord>(header[0].word_count);
+	const span<const char> texts = parser.TakeArray<char>(header[0].text_size);
+	texts_ = { texts.data(), texts.size() };
+	const size_t postings_begin = parser.GetOffset();
+
+	for (size_t ordinal = 0; ordinal < document_ids_.size(); ++ordinal) {
+		CheckSnapshot(document_ids_[ordinal] >= 0
+			&& statuses_[ordinal] >= static_cast<int>(DocumentStatus::ACTUAL)
+			&& statuses_[ordinal] <= static_cast<int>(DocumentStatus::REMOVED));
+	}
+	CheckSnapshot(document_ids_.size() <= static_cast<size_t>(numeric_limits<int>::max()));
+	log_document_count_ = log(static_cast<int>(document_ids_.size()));
+
+	const auto check_text = [this](const SnapshotText& text) {
+		CheckSnapshot(text.size > 0 && text.offset <= texts_.size() && text.size <= texts_.size() - text.offset);
+	};
+	set<string, less<>> stop_word_strings;
+	for (size_t i = 0; i < stop_words.size(); ++i) {
+		check_text(stop_words[i]);
+		const string_view stop_word = GetText(stop_words[i]);
+		CheckSnapshot(i == 0 || GetText(stop_words[i - 1]) < stop_word);
+		//  invalid_argument   ,   SearchServer
+		SearchServer::CheckValidWord(stop_word);
+		stop_word_strings.emplace(stop_word);
+	}
+	stop_words_ = StopWordSet(stop_word_strings);
+
+	//    ,     :   
+	//    -   .
+	for (size_t i = 0; i < words_.size(); ++i) {
+		const SnapshotWord& word = words_[i];
+		check_text(word.text);
+		CheckSnapshot(i == 0 || GetText(words_[i - 1].text) < GetText(word.text));
+		CheckSnapshot(word.postings_offset >= postings_begin && word.postings_offset <= data.size()
+			&& word.postings_offset % SNAPSHOT_ALIGNMENT == 0);
+		const size_t available = data.size() - word.postings_offset;
+		CheckSnapshot(word.posting_count > 0 && word.posting_count <= available / (sizeof(int) + sizeof(double))
+			&& AlignUp(word.posting_count * sizeof(int)) + word.posting_count * sizeof(double) <= available);
+		int previous_ordinal = -1;
+		for (const int ordinal : GetOrdinals(word)) {
+			CheckSnapshot(ordinal > previous_ordinal && static_cast<size_t>(ordinal) < document_ids_.size());
+			previous_ordinal = ordinal;
+		}
+	}
+}
+
+vector<Document> SnapshotIndex::FindTopDocuments(string_view raw_query) const {
+	return FindTopDocuments(raw_query, DocumentStatus::ACTUAL);
+}
+
+vector<Document> SnapshotIndex::FindTopDocuments(string_view raw_query, DocumentStatus status, size_t max_count) const {
+	return FindTopDocuments(raw_query, [status](int, DocumentStatus document_status, int) {
+		return document_status == status;
+		}, max_count);
+}
+
+int SnapshotIndex::GetDocumentCount() const {
+	return static_cast<int>(document_ids_.size());
+}
+
+string_view SnapshotIndex::GetText(const SnapshotText& text) const {
+	return texts_.substr(text.offset, text.size);
+}
+
+span<const int> SnapshotIndex::GetOrdinals(const SnapshotWord& word) const {
+	return { reinterpret_cast<const int*>(data_ + word.postings_offset), word.posting_count };
+}
+
+span<const double> SnapshotIndex::GetTermFreqs(const SnapshotWord& word) const {
+	const size_t offset = word.postings_offset + AlignUp(word.posting_count * sizeof(int));
+	return { reinterpret_cast<const double*>(data_ + offset), word.posting_count };
+}
+
+const SnapshotWord* SnapshotIndex::FindWord(string_view word) const {
+	const auto it = lower_bound(words_.begin(), words_.end(), word,
+		[this](const SnapshotWord& record, string_view text) {
+			return GetText(record.text) < text;
+		});
+	if (it == words_.end() || GetText(it->text) != word) {
+		return nullptr;
+	}
+	return &*it;
+}
+
+void SnapshotIndex::ExcludeMinusWords(const SearchServer::Query& query, pmr::map<int, double>& ordinal_to_relevance) const {
+	for (const string_view word : query.minus_words) {
+		if (ordinal_to_relevance.empty()) {
+			return;
+		}
+		const SnapshotWord* record = FindWord(word);
+		if (record == nullptr) {
+			continue;
+		}
+		//    :      ,
+		//        
+		const span<const int> ordinals = GetOrdinals(*record);
+		if (ordinals.size() < ordinal_to_relevance.size()) {
+			for (const int ordinal : ordinals) {
+				ordinal_to_relevance.erase(ordinal);
+			}
+			continue;
+		}
+		for (auto it = ordinal_to_relevance.begin(); it != ordinal_to_relevance.end();) {
+			if (binary_search(ordinals.begin(), ordinals.end(), it->first)) {
+				it = ordinal_to_relevance.erase(it);
+			}
+			else {
+				++it;
+			}
+		}
+	}
+}
+
+vector<Document> SnapshotIndex::MakeDocuments(const pmr::map<int, double>& ordinal_to_relevance) const {
+	vector<Document> matched_documents;
+	matched_documents.reserve(ordinal_to_relevance.size());
+	for (const auto& [ordinal, relevance] : ordinal_to_relevance) {
+		matched_documents.push_back({ document_ids_[ordinal], relevance, ratings_[ordinal] });
+	}
+	return matched_documents;
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory_resource>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "document.h"
+#include "query_arena.h"
+#include "search_server.h"
+#include "stop_word_set.h"
+
+//   SearchServer::Save.      ,  
+//    SNAPSHOT_ALIGNMENT :
+//   SnapshotHeader
+//   SnapshotText[stop_word_count]           - -  
+//   int32 document_ids[document_count]      -    ,  = 
+//   int32 ratings[document_count]
+//   int32 statuses[document_count]
+//   SnapshotWord[word_count]                -   
+//   char texts[text_size]                   -  -   
+//     : int32 ordinals[posting_count]  ,  double term_freqs[posting_count]
+//   -   ,      
+//  ,     .
+inline constexpr uint32_t SNAPSHOT_MAGIC = 0x56525359;  // "YSRV"
+//      
+inline constexpr uint32_t SNAPSHOT_VERSION = 4;
+inline constexpr size_t SNAPSHOT_ALIGNMENT = 8;
+
+struct SnapshotHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint64_t stop_word_count;
+	uint64_t document_count;
+	uint64_t word_count;
+	uint64_t text_size;
+};
+
+//   texts:    texts  
+struct SnapshotText {
+	uint64_t offset;
+	uint64_t size;
+};
+
+struct SnapshotWord {
+	SnapshotText text;
+	//   ordinals   
+	uint64_t postings_offset;
+	uint64_t posting_count;
+};
+
+// ,      .       ,
+//       .  runtime_error,    .
+class MappedFile {
+public:
+	explicit MappedFile(const std::string& path);
+
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	std::string_view GetData() const;
+
+private:
+	const char* data_ = nullptr;
+	size_t size_ = 0;
+};
+
+//     ,    SearchServer:   ,
+// id,      data  ,    
+//   .      -.
+//  FindTopDocuments    ,    .
+//
+//     const MappedFile file("index.bin");
+//     const SnapshotIndex index(file.GetData());
+//     const auto documents = index.FindTopDocuments(" ");
+//
+//         ( ,
+//    , )   invalid_argument,   
+//   . data     SNAPSHOT_ALIGNMENT    .
+class SnapshotIndex {
+public:
+	explicit SnapshotIndex(std::string_view data);
+
+	std::vector<Document> FindTopDocuments(std::string_view raw_query) const;
+
+	std::vector<Document> FindTopDocuments(std::string_view raw_query,
+		DocumentStatus status, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) const;
+
+	template <typename DocumentPredicate>
+	std::vector<Document> FindTopDocuments(std::string_view raw_query,
+		DocumentPredicate doc_predicate, size_t max_count = MAX_RESULT_DOCUMENT_COUNT) const {
+		QueryArena arena;
+		const SearchServer::Query query = SearchServer::ParseQuery(raw_query, stop_words_, arena.GetResource());
+		std::pmr::map<int, double> ordinal_to_relevance(query.GetResource());
+		for (const std::string_view word : query.plus_words) {
+			const SnapshotWord* record = FindWord(word);
+			if (record == nullptr) {
+				continue;
+			}
+			//  ,  SearchServer::ComputeWordInverseDocumentFreq,     
+			const double inverse_document_freq = log_document_count_ - std::log(record->posting_count);
+			const std::span<const int> ordinals = GetOrdinals(*record);
+			const std::span<const double> term_freqs = GetTermFreqs(*record);
+			for (size_t i = 0; i < ordinals.size(); ++i) {
+				const int ordinal = ordinals[i];
+				if (doc_predicate(document_ids_[ordinal], static_cast<DocumentStatus>(statuses_[ordinal]), ratings_[ordinal])) {
+					ordinal_to_relevance[ordinal] += term_freqs[i] * inverse_document_freq;
+				}
+			}
+		}
+		ExcludeMinusWords(query, ordinal_to_relevance);
+		std::vector<Document> result = MakeDocuments(ordinal_to_relevance);
+		SearchServer::SelectTopDocuments(result, max_count);
+		return result;
+	}
+
+	int GetDocumentCount() const;
+
+private:
+	// Load       
+	friend class SearchServer;
+
+	StopWordSet stop_words_;
+	std::span<const int> document_ids_;
+	std::span<const int> ratings_;
+	std::span<const int> statuses_;
+	std::span<const SnapshotWord> words_;
+	std::string_view texts_;
+	const char* data_ = nullptr;
+	double log_document_count_ = 0.0;
+
+	std::string_view GetText(const SnapshotText& text) const;
+
+	std::span<const int> GetOrdinals(const SnapshotWord& word) const;
+
+	std::span<const double> GetTermFreqs(const SnapshotWord& word) const;
+
+	// nullptr,       
+	const SnapshotWord* FindWord(std::string_view word) const;
+
+	void ExcludeMinusWords(const SearchServer::Query& query, std::pmr::map<int, double>& ordinal_to_relevance) const;
+
+	std::vector<Document> MakeDocuments(const std::pmr::map<int, double>& ordinal_to_relevance) const;
+};
@@ -0,0 +1,81 @@
+#include "stop_word_set.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+namespace {
+	//  seed    ,    
+	const uint32_t MAX_SEED = 1 << 16;
+}
+
+StopWordSet::StopWordSet(const set<string, less<>>& words)
+	: words_(words.begin(), words.end()) {
+	if (words_.empty()) {
+		return;
+	}
+	//  16    :   -  
+	bloom_bits_log_ = 6;
+	while ((size_t{ 1 } << bloom_bits_log_) < words_.size() * 16) {
+		++bloom_bits_log_;
+	}
+	bloom_.assign((size_t{ 1 } << bloom_bits_log_) / 64, 0);
+	for (const string& word : words_) {
+		const uint64_t bloom_bit = Hash(word) >> (64 - bloom_bits_log_);
+		bloom_[bloom_bit / 64] |= uint64_t{ 1 } << (bloom_bit % 64);
+	}
+	//     ,   
+	size_t slot_count = words_.size();
+	while (!TryBuild(slot_count)) {
+		++slot_count;
+	}
+}
+
+bool StopWordSet::TryBuild(size_t slot_count) {
+	const size_t bucket_count = words_.size();
+	seeds_.assign(bucket_count, 0);
+	slots_.assign(slot_count, EMPTY_SLOT);
+
+	vector<vector<uint32_t>> buckets(bucket_count);
+	for (uint32_t i = 0; i < words_.size(); ++i) {
+		buckets[Hash(words_[i]) % bucket_count].push_back(i);
+	}
+	//    ,    
+	vector<size_t> order(bucket_count);
+	iota(order.begin(), order.end(), 0);
+	stable_sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs) {
+		return buckets[lhs].size() > buckets[rhs].size();
+	});
+
+	vector<size_t> bucket_slots;
+	for (const size_t bucket : order) {
+		if (buckets[bucket].empty()) {
+			break;
+		}
+		bool placed = false;
+		for (uint32_t seed = 0; seed < MAX_SEED && !placed; ++seed) {
+			bucket_slots.clear();
+			placed = true;
+			for (const uint32_t word : buckets[bucket]) {
+				const size_t slot = Slot(Hash(words_[word]), seed);
+				if (slots_[slot] != EMPTY_SLOT
+					|| find(bucket_slots.begin(), bucket_slots.end(), slot) != bucket_slots.end()) {
+					placed = false;
+					break;
+				}
+				bucket_slots.push_back(slot);
+			}
+			if (placed) {
+				seeds_[bucket] = seed;
+				for (size_t i = 0; i < bucket_slots.size(); ++i) {
+					slots_[bucket_slots[i]] = buckets[bucket][i];
+				}
+			}
+		}
+		if (!placed) {
+			return false;
+		}
+	}
+	return true;
+}
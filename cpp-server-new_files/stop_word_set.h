@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//   -    - (hash and displace):
+//    ,  seed -  ,       .
+//   -           .
+//      ,       .
+class StopWordSet {
+public:
+	StopWordSet() = default;
+
+	//    
+	explicit StopWordSet(const std::set<std::string, std::less<>>& words);
+
+	bool Contains(std::string_view word) const {
+		if (words_.empty()) {
+			return false;
+		}
+		const uint64_t hash = Hash(word);
+		const uint64_t bloom_bit = hash >> (64 - bloom_bits_log_);
+		if ((bloom_[bloom_bit / 64] >> (bloom_bit % 64) & 1) == 0) {
+			return false;
+		}
+		const uint32_t index = slots_[Slot(hash, seeds_[hash % seeds_.size()])];
+		return index != EMPTY_SLOT && words_[index] == word;
+	}
+
+	size_t size() const {
+		return words_.size();
+	}
+
+	//   
+	std::vector<std::string>::const_iterator begin() const {
+		return words_.begin();
+	}
+
+	std::vector<std::string>::const_iterator end() const {
+		return words_.end();
+	}
+
+private:
+	static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+	std::vector<std::string> words_;
+	std::vector<uint32_t> seeds_;
+	//    words_   
+	std::vector<uint32_t> slots_;
+	std::vector<uint64_t> bloom_;
+	int bloom_bits_log_ = 0;
+
+	// FNV-1a:    ,    std::hash
+	static uint64_t Hash(std::string_view word) {
+		uint64_t hash = 14695981039346656037ULL;
+		for (const char c : word) {
+			hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	size_t Slot(uint64_t hash, uint32_t seed) const {
+		// splitmix64    seed
+		uint64_t mixed = hash + seed * 0x9E3779B97F4A7C15ULL;
+		mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+		return (mixed ^ (mixed >> 31)) % slots_.size();
+	}
+
+	bool TryBuild(size_t slot_count);
+};
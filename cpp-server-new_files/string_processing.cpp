@@ -1,25 +1,101 @@
 #include "string_processing.h"
-#include "string_processing.h"
-{
-	using namespace std;
-	vector<string> string_processing::SplitIntoWords(const string& text) {
-		vector<string> words;
-		string word;
-		for (const char c : text) {
+
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRING_PROCESSING_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+	const char MAX_CONTROL_CHAR = ' ' - 1;
+
+	// spaces -   ,   block_begin:  i -  block_begin + i
+	template <typename Words>
+	void AddWordsBeforeSpaces(string_view text, size_t block_begin, uint32_t spaces, size_t& word_begin,
+		Words& words) {
+		while (spaces != 0) {
+			const size_t space = block_begin + countr_zero(spaces);
+			if (space > word_begin) {
+				words.push_back(text.substr(word_begin, space - word_begin));
+			}
+			word_begin = space + 1;
+			spaces &= spaces - 1;
+		}
+	}
+
+	void RememberFirstControl(size_t block_begin, uint32_t controls, size_t& first_control) {
+		if (controls != 0 && first_control == string_view::npos) {
+			first_control = block_begin + countr_zero(controls);
+		}
+	}
+
+	template <typename Words>
+	string_view SplitIntoWordsImpl(string_view text, Words& words) {
+		const char* const data = text.data();
+		size_t word_begin = 0;
+		size_t first_control = string_view::npos;
+		size_t i = 0;
+		//   -      31,   min(, 31) == .
+#if defined(__AVX2__)
+		const __m256i spaces_32 = _mm256_set1_epi8(' ');
+		const __m256i max_controls_32 = _mm256_set1_epi8(MAX_CONTROL_CHAR);
+		for (; i + 32 <= text.size(); i += 32) {
+			const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+			const auto spaces = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, spaces_32)));
+			const auto controls = static_cast<uint32_t>(_mm256_movemask_epi8(
+				_mm256_cmpeq_epi8(_mm256_min_epu8(block, max_controls_32), block)));
+			RememberFirstControl(i, controls, first_control);
+			AddWordsBeforeSpaces(text, i, spaces, word_begin, words);
+		}
+#endif
+#if defined(STRING_PROCESSING_SSE2)
+		const __m128i spaces_16 = _mm_set1_epi8(' ');
+		const __m128i max_controls_16 = _mm_set1_epi8(MAX_CONTROL_CHAR);
+		for (; i + 16 <= text.size(); i += 16) {
+			const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			const auto spaces = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, spaces_16)));
+			const auto controls = static_cast<uint32_t>(_mm_movemask_epi8(
+				_mm_cmpeq_epi8(_mm_min_epu8(block, max_controls_16), block)));
+			RememberFirstControl(i, controls, first_control);
+			AddWordsBeforeSpaces(text, i, spaces, word_begin, words);
+		}
+#endif
+		for (; i < text.size(); ++i) {
+			const auto c = static_cast<unsigned char>(data[i]);
 			if (c == ' ') {
-				if (!word.empty()) {
-					words.push_back(word);
-					word.clear();
-				}
+				AddWordsBeforeSpaces(text, i, 1, word_begin, words);
 			}
-			else {
-				word += c;
+			else if (c <= static_cast<unsigned char>(MAX_CONTROL_CHAR)) {
+				RememberFirstControl(i, 1, first_control);
 			}
 		}
-		if (!word.empty()) {
-			words.push_back(word);
+		if (text.size() > word_begin) {
+			words.push_back(text.substr(word_begin));
 		}
 
-		return words;
+		if (first_control == string_view::npos) {
+			return {};
+		}
+		const size_t space_before = text.rfind(' ', first_control);
+		const size_t invalid_begin = (space_before == string_view::npos) ? 0 : space_before + 1;
+		const size_t invalid_end = min(text.find(' ', first_control), text.size());
+		return text.substr(invalid_begin, invalid_end - invalid_begin);
 	}
-}
\ No newline at end of file
+}
+
+vector<string_view> SplitIntoWords(string_view text) {
+	vector<string_view> words;
+	SplitIntoWordsImpl(text, words);
+	return words;
+}
+
+string_view SplitIntoWords(string_view text, pmr::vector<string_view>& words) {
+	return SplitIntoWordsImpl(text, words);
+}
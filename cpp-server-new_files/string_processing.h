@@ -1,10 +1,14 @@
 #pragma once
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 
-class string_processing
-{
-	std::vector<std::string> SplitIntoWords(const std::string& text);
-
-};
+//    text  ,    .
+std::vector<std::string_view> SplitIntoWords(std::string_view text);
 
+//  ,     words,        
+//   ( 0-31).      
+//   string_view,   .  x86   
+//  32 (AVX2)  16 (SSE2),    -  .
+std::string_view SplitIntoWords(std::string_view text, std::pmr::vector<std::string_view>& words);
@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <cassert>
@@ -29,20 +30,17 @@ int ReadLineWithNumber() {
 
 vector<string> SplitIntoWords(const string& text) {
 	vector<string> words;
-	string word;
-	for (const char c : text) {
-		if (c == ' ') {
-			if (!word.empty()) {
-				words.push_back(word);
-				word.clear();
-			}
+	const string_view text_view = text;
+	size_t word_begin = 0;
+	while (word_begin < text_view.size()) {
+		size_t word_end = text_view.find(' ', word_begin);
+		if (word_end == string_view::npos) {
+			word_end = text_view.size();
 		}
-		else {
-			word += c;
+		if (word_end > word_begin) {
+			words.emplace_back(text_view.substr(word_begin, word_end - word_begin));
 		}
-	}
-	if (!word.empty()) {
-		words.push_back(word);
+		word_begin = word_end + 1;
 	}
 
 	return words;